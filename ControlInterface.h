@@ -116,6 +116,12 @@ class ControlInterface
 			}
 		}
 
+		// number of commands waiting to be sent
+		virtual unsigned int PendingCommands() { return 0; }
+		// returns false if the control does not queue its commands
+		virtual bool CommandStatistics(__attribute__((unused)) unsigned int& sent, __attribute__((unused)) unsigned int& superseded, __attribute__((unused)) unsigned int& immediately) { return false; }
+		virtual void LocoStatesSent(__attribute__((unused)) const unsigned int sent, __attribute__((unused)) const unsigned int total) {}
+
 		virtual void ProgramRead(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv) {}
 		virtual void ProgramWrite(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
 		virtual void ProgramValue(__attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
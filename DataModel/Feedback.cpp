@@ -38,7 +38,8 @@ namespace DataModel
 		str += ";controlID=" + to_string(controlID);
 		str += ";pin=" + to_string(pin);
 		str += ";inverted=" + to_string(inverted);
-		str += ";state=" + to_string(stateCounter > 0);
+		str += ";state=" + to_string(state);
+		str += ";debouncetime=" + to_string(debounceTime);
 		str += ";" + relatedObject.Serialize();
 		return str;
 	}
@@ -59,37 +60,61 @@ namespace DataModel
 		controlID = Utils::Utils::GetIntegerMapEntry(arguments, "controlID", ControlIdNone);
 		pin = Utils::Utils::GetIntegerMapEntry(arguments, "pin");
 		inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted", false);
-		stateCounter = Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree) ? MaxStateCounter : 0;
+		state = static_cast<FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree));
+		debounceTime = LimitDebounceTime(Utils::Utils::GetIntegerMapEntry(arguments, "debouncetime", DefaultDebounceTime));
 		relatedObject.Deserialize(arguments);
 		return true;
 	}
 
 	void Feedback::SetState(const FeedbackState newState)
 	{
-		FeedbackState state = static_cast<FeedbackState>(newState != inverted);
+		FeedbackState reportedState = static_cast<FeedbackState>(newState != inverted);
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (state == FeedbackStateFree)
+			if (reportedState == FeedbackStateFree)
 			{
-				if (stateCounter < MaxStateCounter)
+				if (state == FeedbackStateFree || debouncing)
 				{
 					return;
 				}
-				stateCounter = MaxStateCounter - 1;
-				return;
+				if (debounceTime > 0)
+				{
+					debouncing = true;
+					debounceDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(debounceTime);
+					manager->FeedbackDebounce(GetID(), debounceDeadline);
+					return;
+				}
+				state = FeedbackStateFree;
+			}
+			else
+			{
+				debouncing = false;
+				if (state == FeedbackStateOccupied)
+				{
+					return;
+				}
+				state = FeedbackStateOccupied;
 			}
+		}
 
-			unsigned char oldStateCounter = stateCounter;
-			stateCounter = MaxStateCounter;
+		manager->FeedbackPublishState(this);
+		UpdateTrackState(reportedState);
+	}
 
-			if (oldStateCounter > 0)
+	void Feedback::Debounce(const DebounceDeadline deadline)
+	{
+		{
+			std::lock_guard<std::mutex> Guard(updateMutex);
+			if (debouncing == false || debounceDeadline > deadline)
 			{
 				return;
 			}
+			debouncing = false;
+			state = FeedbackStateFree;
 		}
 
 		manager->FeedbackPublishState(this);
-		UpdateTrackState(FeedbackStateOccupied);
+		UpdateTrackState(FeedbackStateFree);
 	}
 
 	void Feedback::UpdateTrack()
@@ -123,24 +148,5 @@ namespace DataModel
 		}
 		track->SetFeedbackState(GetID(), state);
 	}
-
-	void Feedback::Debounce()
-	{
-		{
-			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (stateCounter == MaxStateCounter || stateCounter == 0)
-			{
-				return;
-			}
-
-			--stateCounter;
-			if (stateCounter != 0)
-			{
-				return;
-			}
-		}
-		manager->FeedbackPublishState(this);
-		UpdateTrackState(FeedbackStateFree);
-	}
 } // namespace DataModel
 
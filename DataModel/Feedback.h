@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 
@@ -43,6 +44,13 @@ namespace DataModel
 				FeedbackStateOccupied = true
 			};
 
+			// time in ms a feedback has to be free before the free state is published
+			typedef uint16_t DebounceTime;
+			static const DebounceTime DefaultDebounceTime = 2000;
+			static const DebounceTime MaxDebounceTime = 60000;
+
+			typedef std::chrono::steady_clock::time_point DebounceDeadline;
+
 			inline Feedback(Manager* manager,
 				const FeedbackID feedbackID)
 			:	LayoutItem(feedbackID),
@@ -52,13 +60,16 @@ namespace DataModel
 			 	inverted(false),
 			 	relatedObject(),
 			 	track(nullptr),
-				stateCounter(0)
+				state(FeedbackStateFree),
+				debounceTime(DefaultDebounceTime),
+				debouncing(false)
 			{
 			}
 
 			inline Feedback(Manager* manager, const std::string& serialized)
 			:	manager(manager),
-				track(nullptr)
+				track(nullptr),
+				debouncing(false)
 			{
 				Deserialize(serialized);
 			}
@@ -91,10 +102,35 @@ namespace DataModel
 
 			inline FeedbackState GetState() const
 			{
-				return static_cast<FeedbackState>(stateCounter > 0);
+				return state;
+			}
+
+			inline void SetDebounceTime(const DebounceTime debounceTime)
+			{
+				this->debounceTime = debounceTime;
+			}
+
+			inline DebounceTime GetDebounceTime() const
+			{
+				return debounceTime;
+			}
+
+			// values read from the user or the database are limited to the allowed range before they are narrowed
+			static inline DebounceTime LimitDebounceTime(const int debounceTime)
+			{
+				if (debounceTime < 0)
+				{
+					return 0;
+				}
+				if (debounceTime > MaxDebounceTime)
+				{
+					return MaxDebounceTime;
+				}
+				return static_cast<DebounceTime>(debounceTime);
 			}
 
-			void Debounce();
+			// called by the debouncer of the manager when the deadline of this feedback has been reached
+			void Debounce(const DebounceDeadline deadline);
 
 			inline void SetControlID(const ControlID controlID)
 			{
@@ -160,8 +196,10 @@ namespace DataModel
 			bool inverted;
 			ObjectIdentifier relatedObject;
 			TrackBase* track;
-			unsigned char stateCounter;
-			static const unsigned char MaxStateCounter = 10;
+			FeedbackState state;
+			DebounceTime debounceTime;
+			bool debouncing;
+			DebounceDeadline debounceDeadline;
 			mutable std::mutex updateMutex;
 	};
 
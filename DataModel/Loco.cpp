@@ -48,6 +48,7 @@ namespace DataModel
 			logger->Info(Languages::TextWaitingUntilHasStopped, name);
 			Utils::Utils::SleepForSeconds(1);
 		}
+		manager->GetLocoScheduler().Remove(this);
 		DeleteSlaves();
 	}
 
@@ -164,6 +165,7 @@ namespace DataModel
 		feedbackIdCreep = FeedbackNone;
 		feedbackIdReduced = FeedbackNone;
 		feedbackIdFirst = FeedbackNone;
+		manager->GetLocoScheduler().WakeWaiting();
 		return true;
 	}
 
@@ -188,7 +190,6 @@ namespace DataModel
 		}
 		if (state == LocoStateTerminated)
 		{
-			locoThread.join();
 			state = LocoStateManual;
 		}
 		if (state != LocoStateManual)
@@ -197,8 +198,10 @@ namespace DataModel
 			return false;
 		}
 
+		logger->Info(Languages::TextIsNowInAutoMode, name);
 		state = LocoStateSearchingFirst;
-		locoThread = std::thread(&DataModel::Loco::AutoMode, this);
+		departure = std::chrono::steady_clock::time_point();
+		manager->GetLocoScheduler().Wake(this);
 
 		return true;
 	}
@@ -210,6 +213,7 @@ namespace DataModel
 			return;
 		}
 		requestManualMode = true;
+		manager->GetLocoScheduler().Wake(this);
 	}
 
 	bool Loco::GoToManualMode()
@@ -222,134 +226,135 @@ namespace DataModel
 		{
 			return false;
 		}
-		locoThread.join();
 		state = LocoStateManual;
 		return true;
 	}
 
 	void Loco::ForceManualMode()
 	{
+		// the state machine only runs with stateMutex locked, so it can be stopped right here
+		std::lock_guard<std::mutex> Guard(stateMutex);
+		switch (state)
 		{
-			std::lock_guard<std::mutex> Guard(stateMutex);
-			switch (state)
-			{
-				case LocoStateManual:
-					return;
+			case LocoStateManual:
+				return;
 
-				case LocoStateTerminated:
-					break;
+			case LocoStateTerminated:
+				break;
 
-				default:
-					state = LocoStateOff;
-					break;
-			}
+			default:
+				logger->Info(Languages::TextIsNowInManualMode, name);
+				break;
 		}
-		locoThread.join();
 		state = LocoStateManual;
+		requestManualMode = false;
 	}
 
-	void Loco::AutoMode()
+	LocoScheduler::Delay Loco::AutoModeStep()
 	{
-		Utils::Utils::SetMinThreadPriority();
-		const string& name = GetName();
-		Utils::Utils::SetThreadName(name);
-		logger->Info(Languages::TextIsNowInAutoMode, name);
+		std::lock_guard<std::mutex> Guard(stateMutex);
+		while (feedbackIdsReached.IsEmpty() == false)
+		{
+			FeedbackID feedbackId = feedbackIdsReached.Dequeue();
+			if (feedbackId == feedbackIdFirst)
+			{
+				FeedbackIdFirstReached();
+			}
+			else if (feedbackId == feedbackIdStop)
+			{
+				FeedbackIdStopReached();
+			}
+		}
 
+		// a step that changed the state is followed by the step of the new state
 		while (true)
 		{
-			{ // sleep must be outside of locked block
-				std::lock_guard<std::mutex> Guard(stateMutex);
-				if (feedbackIdsReached.IsEmpty() == false)
+			const LocoState oldState = state;
+			const LocoScheduler::Delay delay = AutoModeState();
+			if (state == oldState)
+			{
+				return delay;
+			}
+		}
+	}
+
+	LocoScheduler::Delay Loco::AutoModeState()
+	{
+		switch (state)
+		{
+			case LocoStateOff:
+				// automode is turned off
+				logger->Info(Languages::TextIsNowInManualMode, name);
+				state = LocoStateTerminated;
+				requestManualMode = false;
+				return LocoScheduler::WaitForEvent;
+
+			case LocoStateSearchingFirst:
+			{
+				if (requestManualMode)
 				{
-					FeedbackID feedbackId = feedbackIdsReached.Dequeue();
-					if (feedbackId == feedbackIdFirst)
-					{
-						FeedbackIdFirstReached();
-					}
-					else if (feedbackId == feedbackIdStop)
-					{
-						FeedbackIdStopReached();
-					}
-					continue;
+					state = LocoStateOff;
+					return LocoScheduler::WaitForEvent;
 				}
-
-				switch (state)
+				const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				if (wait > 0)
+				{
+					departure = now + std::chrono::seconds(wait);
+					wait = 0;
+				}
+				if (departure > now)
 				{
-					case LocoStateOff:
-						// automode is turned off, terminate thread
-						logger->Info(Languages::TextIsNowInManualMode, name);
-						state = LocoStateTerminated;
-						requestManualMode = false;
-						return;
-
-					case LocoStateSearchingFirst:
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-							break;
-						}
-						if (wait > 0)
-						{
-							--wait;
-							break;
-						}
-						SearchDestinationFirst();
-						break;
-
-					case LocoStateSearchingSecond:
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-							break;
-						}
-						if (manager->GetNrOfTracksToReserve() <= 1)
-						{
-							break;
-						}
-						if (wait > 0)
-						{
-							break;
-						}
-						SearchDestinationSecond();
-						break;
-
-					case LocoStateRunning:
-						// loco is already running, waiting until destination reached
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-						}
-						break;
-
-					case LocoStateStopping:
-						logger->Info(Languages::TextHasNotReachedDestination, name);
-
-						break;
-
-					case LocoStateTerminated:
-						logger->Error(Languages::TextIsInTerminatedState, name);
-						state = LocoStateError;
-						break;
-
-					case LocoStateManual:
-						logger->Error(Languages::TextIsInManualState, name);
-						state = LocoStateError;
-						#include "Fallthrough.h"
-
-					case LocoStateError:
-						logger->Error(Languages::TextIsInErrorState, name);
-						manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-						}
-						break;
+					return std::chrono::duration_cast<LocoScheduler::Delay>(departure - now) + LocoScheduler::Delay(1);
 				}
+				SearchDestinationFirst();
+				return manager->GetLocoScheduler().GetRetryInterval();
 			}
-			// FIXME: make configurable
-			Utils::Utils::SleepForSeconds(1);
+
+			case LocoStateSearchingSecond:
+				if (requestManualMode)
+				{
+					logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+					state = LocoStateStopping;
+					return LocoScheduler::WaitForEvent;
+				}
+				if (manager->GetNrOfTracksToReserve() <= 1)
+				{
+					return LocoScheduler::WaitForEvent;
+				}
+				if (wait > 0)
+				{
+					return LocoScheduler::WaitForEvent;
+				}
+				SearchDestinationSecond();
+				return manager->GetLocoScheduler().GetRetryInterval();
+
+			case LocoStateRunning:
+				// loco is already running, waiting until destination reached
+				if (requestManualMode)
+				{
+					logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+					state = LocoStateStopping;
+				}
+				return LocoScheduler::WaitForEvent;
+
+			case LocoStateStopping:
+				logger->Info(Languages::TextHasNotReachedDestination, name);
+				return LocoScheduler::WaitForEvent;
+
+			case LocoStateManual:
+			case LocoStateTerminated:
+				// woken after the automode has been left
+				return LocoScheduler::WaitForEvent;
+
+			case LocoStateError:
+			default:
+				logger->Error(Languages::TextIsInErrorState, name);
+				manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+				if (requestManualMode)
+				{
+					state = LocoStateOff;
+				}
+				return LocoScheduler::WaitForEvent;
 		}
 	}
 
@@ -581,6 +586,7 @@ namespace DataModel
 				feedbackIdsReached.Enqueue(feedbackIdFirst);
 			}
 			feedbackIdsReached.Enqueue(feedbackIdStop);
+			manager->GetLocoScheduler().Wake(this);
 			return;
 		}
 
@@ -593,6 +599,7 @@ namespace DataModel
 			if (feedbackIdFirst != 0)
 			{
 				feedbackIdsReached.Enqueue(feedbackIdFirst);
+				manager->GetLocoScheduler().Wake(this);
 			}
 			return;
 		}
@@ -606,6 +613,7 @@ namespace DataModel
 			if (feedbackIdFirst != 0)
 			{
 				feedbackIdsReached.Enqueue(feedbackIdFirst);
+				manager->GetLocoScheduler().Wake(this);
 			}
 			return;
 		}
@@ -613,10 +621,30 @@ namespace DataModel
 		if (feedbackID == feedbackIdFirst)
 		{
 			feedbackIdsReached.Enqueue(feedbackIdFirst);
+			manager->GetLocoScheduler().Wake(this);
 			return;
 		}
 	}
 
+	void Loco::GetExpectedFeedbacks(std::vector<FeedbackID>& feedbacks) const
+	{
+		std::lock_guard<std::mutex> Guard(stateMutex);
+		for (auto route : { routeFirst, routeSecond })
+		{
+			if (route == nullptr)
+			{
+				continue;
+			}
+			for (auto feedbackID : { route->GetFeedbackIdReduced(), route->GetFeedbackIdCreep(), route->GetFeedbackIdStop() })
+			{
+				if (feedbackID != FeedbackNone)
+				{
+					feedbacks.push_back(feedbackID);
+				}
+			}
+		}
+	}
+
 	void Loco::SetSpeed(const Speed speed, const bool withSlaves)
 	{
 		this->speed = speed;
@@ -680,6 +708,7 @@ namespace DataModel
 		trackFrom = trackFirst;
 		trackFirst = trackSecond;
 		trackSecond = nullptr;
+		manager->GetLocoScheduler().WakeWaiting();
 
 		// set state
 		switch (state)
@@ -718,6 +747,7 @@ namespace DataModel
 		trackFrom->BaseRelease(logger, objectID);
 		trackFrom = trackFirst;
 		trackFirst = nullptr;
+		manager->GetLocoScheduler().WakeWaiting();
 		logger->Info(Languages::TextReachedItsDestination, name);
 
 		// set state
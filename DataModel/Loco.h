@@ -20,9 +20,9 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include "DataTypes.h"
@@ -31,6 +31,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LocoFunctions.h"
 #include "DataModel/Object.h"
 #include "DataModel/Relation.h"
+#include "LocoScheduler.h"
 #include "Utils/ThreadSafeQueue.h"
 
 class Manager;
@@ -75,7 +76,8 @@ namespace DataModel
 				feedbackIdStop(FeedbackNone),
 				feedbackIdOver(FeedbackNone),
 				feedbackIdsReached(),
-				wait(0)
+				wait(0),
+				departure()
 			{
 				logger = Logger::Logger::GetLogger(GetName());
 			}
@@ -112,12 +114,19 @@ namespace DataModel
 			void RequestManualMode();
 			bool GoToManualMode();
 
+			// processes the reached feedbacks and advances the automode state machine, called by the LocoScheduler
+			// returns the time until the loco has to be stepped again without an event
+			LocoScheduler::Delay AutoModeStep();
+
 			bool SetTrack(const DataModel::ObjectIdentifier& identifier);
 			bool Release();
 			bool IsRunningFromTrack(const TrackID trackID) const;
 
 			void LocationReached(const FeedbackID feedbackID);
 
+			// feedbacks of the reserved routes in the order the loco reaches them
+			void GetExpectedFeedbacks(std::vector<FeedbackID>& feedbacks) const;
+
 			void SetSpeed(const Speed speed, const bool withSlaves);
 
 			inline Speed GetSpeed() const
@@ -245,8 +254,7 @@ namespace DataModel
 			}
 
 		private:
-			void SetMinThreadPriorityAndThreadName();
-			void AutoMode();
+			LocoScheduler::Delay AutoModeState();
 			void SearchDestinationFirst();
 			void SearchDestinationSecond();
 			DataModel::Route* SearchDestination(DataModel::TrackBase* oldToTrack, const bool allowLocoTurn);
@@ -269,7 +277,6 @@ namespace DataModel
 
 			Manager* manager;
 			mutable std::mutex stateMutex;
-			std::thread locoThread;
 
 			Length length;
 			bool pushpull;
@@ -297,6 +304,8 @@ namespace DataModel
 			volatile FeedbackID feedbackIdOver;
 			Utils::ThreadSafeQueue<FeedbackID> feedbackIdsReached;
 			Pause wait;
+			// the loco does not leave its track before, set when the destination is reached
+			std::chrono::steady_clock::time_point departure;
 
 			LocoFunctions functions;
 
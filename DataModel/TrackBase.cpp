@@ -215,6 +215,11 @@ namespace DataModel
 			}
 		}
 		PublishState();
+		if (newTrackState == DataModel::Feedback::FeedbackStateFree)
+		{
+			// locos waiting for a route may reserve this track now
+			manager->GetLocoScheduler().WakeWaiting();
+		}
 		return true;
 	}
 
@@ -289,6 +294,7 @@ namespace DataModel
 			}
 		}
 		routes.push_back(route);
+		routeCandidates.clear();
 		return true;
 	}
 
@@ -298,6 +304,7 @@ namespace DataModel
 		size_t sizeBefore = routes.size();
 		routes.erase(std::remove(routes.begin(), routes.end(), route), routes.end());
 		size_t sizeAfter = routes.size();
+		routeCandidates.clear();
 		return sizeBefore > sizeAfter;
 	}
 
@@ -316,13 +323,25 @@ namespace DataModel
 		std::vector<Route*>& validRoutes) const
 	{
 		std::lock_guard<std::mutex> Guard(updateMutex);
-		for (auto route : routes)
+		const RouteCandidatesKey key(locoOrientation, allowLocoTurn, loco->GetLength(), loco->GetPushpull());
+		auto candidates = routeCandidates.find(key);
+		if (candidates == routeCandidates.end())
 		{
-			if (route->FromTrackOrientation(logger, GetObjectIdentifier(), locoOrientation, loco, allowLocoTurn))
+			vector<Route*>& newCandidates = routeCandidates[key];
+			for (auto route : routes)
 			{
-				validRoutes.push_back(route);
+				if (route->FromTrackOrientation(logger, GetObjectIdentifier(), locoOrientation, loco, allowLocoTurn))
+				{
+					newCandidates.push_back(route);
+				}
 			}
+			validRoutes = newCandidates;
+		}
+		else
+		{
+			validRoutes = candidates->second;
 		}
+		// only the order depends on the state of the routes
 		OrderValidRoutes(validRoutes);
 		return true;
 	}
@@ -22,6 +22,8 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <map>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "DataModel/Cluster.h"
 #include "DataModel/Feedback.h"
@@ -183,7 +185,9 @@ namespace DataModel
 
 			inline void SetAllowLocoTurn(bool allowLocoTurn)
 			{
+				std::lock_guard<std::mutex> Guard(updateMutex);
 				this->allowLocoTurn = allowLocoTurn;
+				routeCandidates.clear();
 			}
 
 			inline FeedbackID GetFirstFeedbackId()
@@ -234,6 +238,10 @@ namespace DataModel
 			DataModel::Feedback::FeedbackState trackState;
 			DataModel::Feedback::FeedbackState trackStateDelayed;
 			std::vector<Route*> routes;
+			// routes of this track that fit the track orientation, loco turn permission, loco length and pushpull,
+			// built on first use and cleared whenever the routes change
+			typedef std::tuple<Orientation,bool,Length,bool> RouteCandidatesKey;
+			mutable std::map<RouteCandidatesKey,std::vector<Route*>> routeCandidates;
 			Orientation locoOrientation;
 			bool blocked;
 			LocoID locoIdDelayed;
@@ -151,7 +151,11 @@ enum ArgumentType : uint8_t
 {
 	ArgumentTypeIpAddress = 1,
 	ArgumentTypeSerialPort = 2,
-	ArgumentTypeS88Modules = 3
+	ArgumentTypeS88Modules = 3,
+	ArgumentTypeFileName = 4,
+	ArgumentTypeReplaySpeed = 5,
+	ArgumentTypeSectionTime = 6,
+	ArgumentTypeMaxEnergisedAccessories = 7
 };
 
 enum HardwareType : uint8_t
@@ -167,6 +171,8 @@ enum HardwareType : uint8_t
 	HardwareTypeCcSchnitte = 8,
 	HardwareTypeEcos = 9,
 	HardwareTypeCS2Tcp = 10,
+	HardwareTypeCS2Replay = 11,
+	HardwareTypeSimulation = 12,
 	HardwareTypeNumbers
 };
 
@@ -0,0 +1,187 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "Hardware/CS2Replay.h"
+#include "Logger/PacketCapture.h"
+#include "Utils/Utils.h"
+
+using std::string;
+
+namespace Hardware
+{
+	extern "C" CS2Replay* create_CS2Replay(HardwareParams* const params)
+	{
+		return new CS2Replay(params);
+	}
+
+	extern "C" void destroy_CS2Replay(CS2Replay* const cs2Replay)
+	{
+		delete(cs2Replay);
+	}
+
+	CS2Replay::CS2Replay(HardwareParams* const params)
+	:	ProtocolMaerklinCAN(params,
+			Logger::Logger::GetLogger("CS2Replay " + params->GetName()),
+			"Maerklin Central Station 2 (CS2) Replay / " + params->GetName() + " of " + params->GetArg1()),
+		fileName(params->GetArg1()),
+		// an empty speed replays in real time
+		speed(params->GetArg2().empty() ? 1 : static_cast<unsigned int>(Utils::Utils::StringToInteger(params->GetArg2(), 0, 1000))),
+		firstTimestamp(0),
+		feedbackPending(false),
+		reactions(0),
+		reactionTimeSum(0),
+		reactionTimeMax(0)
+	{
+		logger->Info(Languages::TextStarting, name);
+		run = true;
+		replayThread = std::thread(&Hardware::CS2Replay::Receiver, this);
+	}
+
+	CS2Replay::~CS2Replay()
+	{
+		// ProtocolMaerklinCAN has not started any thread, so it must not join them
+		run = false;
+		replayThread.join();
+	}
+
+	void CS2Replay::Send(const unsigned char* buffer)
+	{
+		const CanCommand command = ParseCommand(buffer);
+		if (command != CanCommandLocoSpeed && command != CanCommandLocoDirection && command != CanCommandLocoFunction)
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> guard(reactionMutex);
+		if (feedbackPending == false)
+		{
+			return;
+		}
+		feedbackPending = false;
+		const uint64_t reactionTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - feedbackTime).count();
+		++reactions;
+		reactionTimeSum += reactionTime;
+		if (reactionTime > reactionTimeMax)
+		{
+			reactionTimeMax = reactionTime;
+		}
+	}
+
+	bool CS2Replay::WaitFor(const std::chrono::steady_clock::time_point& start, const uint64_t timestamp)
+	{
+		if (speed == 0)
+		{
+			return run;
+		}
+		// captures of railcontrol have steady timestamps, captures of other tools may jump backwards
+		const uint64_t offset = timestamp > firstTimestamp ? (timestamp - firstTimestamp) / speed : 0;
+		const std::chrono::steady_clock::time_point due = start + std::chrono::microseconds(offset);
+		while (run)
+		{
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (now >= due)
+			{
+				return true;
+			}
+			// wakes up regularly to be able to stop a slow replay
+			std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(due - now, std::chrono::milliseconds(100)));
+		}
+		return false;
+	}
+
+	void CS2Replay::Receiver()
+	{
+		Utils::Utils::SetThreadName("CS2Replay");
+		logger->Info(Languages::TextReceiverThreadStarted);
+
+		// the objects of the manager are loaded after the controls have been started
+		while (run && manager->IsRunning() == false)
+		{
+			Utils::Utils::SleepForMilliseconds(100);
+		}
+
+		std::ifstream file(fileName, std::ifstream::binary);
+		Logger::PacketCapture::FileHeader fileHeader;
+		if (file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)).good() == false
+			|| fileHeader.magic != Logger::PacketCapture::Magic
+			|| fileHeader.linkType != Logger::PacketCapture::LinkTypeUser0)
+		{
+			logger->Error(Languages::TextInvalidPacketCapture, fileName);
+			return;
+		}
+
+		logger->Info(Languages::TextReplayStarted, fileName);
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Logger::PacketCapture::RecordHeader header;
+		std::vector<unsigned char> record;
+		unsigned char buffer[CANCommandBufferLength];
+		unsigned int frames = 0;
+		while (run && file.read(reinterpret_cast<char*>(&header), sizeof(header)).good())
+		{
+			record.resize(header.capturedLength);
+			if (file.read(reinterpret_cast<char*>(record.data()), record.size()).good() == false)
+			{
+				break;
+			}
+
+			// the capture contains the frames of both directions, only received ones are parsed
+			if (record.size() < 1 || record[0] != Logger::PacketCapture::DirectionReceived)
+			{
+				continue;
+			}
+
+			const uint64_t timestamp = static_cast<uint64_t>(header.seconds) * 1000000 + header.microseconds;
+			if (frames == 0)
+			{
+				firstTimestamp = timestamp;
+			}
+			if (WaitFor(start, timestamp) == false)
+			{
+				break;
+			}
+
+			// only the header and the used data bytes of a CAN frame are captured
+			memset(buffer, 0, sizeof(buffer));
+			memcpy(buffer, record.data() + 1, std::min(record.size() - 1, sizeof(buffer)));
+			if (ParseCommand(buffer) == CanCommandS88Event && ParseResponse(buffer) == CanResponseResponse)
+			{
+				std::lock_guard<std::mutex> guard(reactionMutex);
+				feedbackPending = true;
+				feedbackTime = std::chrono::steady_clock::now();
+			}
+			Parse(buffer);
+			++frames;
+		}
+
+		const uint64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+		logger->Info(Languages::TextReplayFinished, frames, duration);
+
+		std::lock_guard<std::mutex> guard(reactionMutex);
+		if (reactions > 0)
+		{
+			logger->Info(Languages::TextReplayReactionTime, reactions, reactionTimeSum / reactions, reactionTimeMax);
+		}
+		logger->Info(Languages::TextTerminatingReceiverThread);
+	}
+} // namespace
@@ -0,0 +1,73 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Hardware/HardwareParams.h"
+#include "Hardware/ProtocolMaerklinCAN.h"
+#include "Logger/Logger.h"
+
+namespace Hardware
+{
+	// replays the frames of a packet capture recorded from a CS2/CS3 or CC-Schnitte without any hardware
+	// the frames railcontrol sends are dropped, they are only used to measure the reaction time on feedbacks
+	class CS2Replay : protected ProtocolMaerklinCAN
+	{
+		public:
+			CS2Replay(HardwareParams* const params);
+			~CS2Replay();
+
+			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
+			{
+				argumentTypes[1] = ArgumentTypeFileName;
+				argumentTypes[2] = ArgumentTypeReplaySpeed;
+				hint = Languages::GetText(Languages::TextHintCs2Replay);
+			}
+
+		private:
+			void Send(const unsigned char* buffer) override;
+			void Receiver() override;
+
+			// waits until timestamp of the capture is reached, returns false if the replay has been stopped
+			bool WaitFor(const std::chrono::steady_clock::time_point& start, const uint64_t timestamp);
+
+			const std::string fileName;
+			// 0 replays as fast as possible, 1 with the recorded timing, n n-times faster
+			const unsigned int speed;
+			uint64_t firstTimestamp;
+			std::thread replayThread;
+
+			std::mutex reactionMutex;
+			bool feedbackPending;
+			std::chrono::steady_clock::time_point feedbackTime;
+			unsigned int reactions;
+			uint64_t reactionTimeSum;
+			uint64_t reactionTimeMax;
+	};
+
+	extern "C" CS2Replay* create_CS2Replay(HardwareParams* const params);
+	extern "C" void destroy_CS2Replay(CS2Replay* const cs2Replay);
+
+} // namespace
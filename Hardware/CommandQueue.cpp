@@ -0,0 +1,191 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Hardware/CommandQueue.h"
+#include "Utils/Utils.h"
+
+namespace Hardware
+{
+	const CommandQueue::Key CommandQueue::NoKey = 0;
+
+	CommandQueue::CommandQueue()
+	:	run(false),
+		rate(0),
+		burst(1),
+		tokens(1),
+		statistics()
+	{
+	}
+
+	CommandQueue::~CommandQueue()
+	{
+		Terminate();
+	}
+
+	void CommandQueue::Start(const std::string& name, const unsigned int rate, const unsigned int burst)
+	{
+		Terminate();
+		std::lock_guard<std::mutex> guard(mutex);
+		this->rate = rate;
+		this->burst = burst > 0 ? burst : 1;
+		tokens = this->burst;
+		statistics = Statistics();
+		lastRefill = std::chrono::steady_clock::now();
+		run = true;
+		senderThread = std::thread(&CommandQueue::Sender, this, name);
+	}
+
+	void CommandQueue::Terminate()
+	{
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			run = false;
+		}
+		queueCondition.notify_all();
+		if (senderThread.joinable())
+		{
+			senderThread.join();
+		}
+	}
+
+	void CommandQueue::Enqueue(const Command& command, const unsigned int cost, const Key key)
+	{
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			if (!run)
+			{
+				return;
+			}
+			// the newer command is appended, so it can not overtake commands queued in between
+			DropUnlocked(key);
+			queue.emplace_back(command, cost, key);
+			if (key != NoKey)
+			{
+				queuedKeys[key] = std::prev(queue.end());
+			}
+		}
+		queueCondition.notify_one();
+	}
+
+	void CommandQueue::SendImmediately(const Command& command, const Key key)
+	{
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			DropUnlocked(key);
+			++statistics.immediately;
+		}
+		std::lock_guard<std::mutex> guard(sendMutex);
+		command();
+	}
+
+	bool CommandQueue::Drop(const Key key)
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return DropUnlocked(key);
+	}
+
+	bool CommandQueue::DropUnlocked(const Key key)
+	{
+		if (key == NoKey)
+		{
+			return false;
+		}
+		auto queued = queuedKeys.find(key);
+		if (queued == queuedKeys.end())
+		{
+			return false;
+		}
+		queue.erase(queued->second);
+		queuedKeys.erase(queued);
+		++statistics.superseded;
+		return true;
+	}
+
+	CommandQueue::Statistics CommandQueue::GetStatistics()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return statistics;
+	}
+
+	unsigned int CommandQueue::Pending()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		return queue.size();
+	}
+
+	void CommandQueue::Refill(const std::chrono::steady_clock::time_point now)
+	{
+		const std::chrono::duration<double> elapsed = now - lastRefill;
+		lastRefill = now;
+		tokens += elapsed.count() * rate;
+		if (tokens > burst)
+		{
+			tokens = burst;
+		}
+	}
+
+	void CommandQueue::Sender(const std::string name)
+	{
+		// thread names are limited to 15 characters
+		Utils::Utils::SetThreadName(name.substr(0, 15));
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			if (queue.empty())
+			{
+				if (!run)
+				{
+					return;
+				}
+				queueCondition.wait(lock);
+				continue;
+			}
+
+			if (rate > 0)
+			{
+				Refill(std::chrono::steady_clock::now());
+				// a command costing more than one token may leave the bucket in debt,
+				// the next command waits until the debt is paid back
+				if (tokens < 1)
+				{
+					const std::chrono::duration<double> wait((1 - tokens) / rate);
+					queueCondition.wait_for(lock, wait);
+					continue;
+				}
+				tokens -= queue.front().cost;
+			}
+
+			Command command = queue.front().command;
+			if (queue.front().key != NoKey)
+			{
+				queuedKeys.erase(queue.front().key);
+			}
+			queue.pop_front();
+			++statistics.sent;
+			{
+				// sendMutex is taken before mutex is released, so SendImmediately can not overtake this command
+				std::lock_guard<std::mutex> guard(sendMutex);
+				lock.unlock();
+				command();
+			}
+			lock.lock();
+		}
+	}
+} // namespace Hardware
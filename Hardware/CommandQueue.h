@@ -0,0 +1,117 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Hardware
+{
+	// sends the commands of one control on its own thread
+	// a token bucket limits the rate to what the command station can handle without losing commands
+	// a queued command with a key is superseded by a newer command with the same key
+	class CommandQueue
+	{
+		public:
+			typedef std::function<void()> Command;
+			typedef uint64_t Key;
+
+			// commands without key are never superseded
+			static const Key NoKey;
+
+			struct Statistics
+			{
+				unsigned int sent;
+				unsigned int superseded;
+				unsigned int immediately;
+			};
+
+			CommandQueue(const CommandQueue&) = delete;
+			CommandQueue& operator=(const CommandQueue&) = delete;
+
+			CommandQueue();
+			~CommandQueue();
+
+			// rate is the number of commands per second (0 means unlimited),
+			// burst is the number of commands that may be sent back to back after an idle time
+			void Start(const std::string& name, const unsigned int rate, const unsigned int burst);
+
+			// sends the commands still queued and stops the sender thread
+			void Terminate();
+
+			// cost is the number of commands the command station receives when executing command
+			// a queued command with the same key is dropped
+			void Enqueue(const Command& command, const unsigned int cost = 1, const Key key = NoKey);
+
+			// drops a queued command with the same key and executes command on the calling thread
+			// without waiting for the rate limit, a command currently sent by the queue is finished first
+			void SendImmediately(const Command& command, const Key key = NoKey);
+
+			// drops a queued command with key, returns false if none was queued
+			bool Drop(const Key key);
+
+			Statistics GetStatistics();
+
+			// number of commands waiting to be sent
+			unsigned int Pending();
+
+		private:
+			struct Entry
+			{
+				Entry(const Command& command, const unsigned int cost, const Key key)
+				:	command(command),
+					cost(cost),
+					key(key)
+				{}
+
+				Command command;
+				unsigned int cost;
+				Key key;
+			};
+
+			bool DropUnlocked(const Key key);
+
+			void Sender(const std::string name);
+			void Refill(const std::chrono::steady_clock::time_point now);
+
+			std::list<Entry> queue;
+			std::map<Key,std::list<Entry>::iterator> queuedKeys;
+			std::mutex mutex;
+			// held while a command is executed so that commands never overtake each other
+			std::mutex sendMutex;
+			std::condition_variable queueCondition;
+			volatile bool run;
+			std::thread senderThread;
+
+			double rate;
+			double burst;
+			double tokens;
+			std::chrono::steady_clock::time_point lastRefill;
+			Statistics statistics;
+	};
+} // namespace Hardware
@@ -122,6 +122,7 @@ namespace Hardware
 
 	void Ecos::Send(const char* data)
 	{
+		logger->Sent(reinterpret_cast<const unsigned char*>(data), strlen(data));
 		int ret = tcp.Send(data);
 		if (ret < 0)
 		{
@@ -193,7 +194,7 @@ namespace Hardware
 		{
 			return;
 		}
-		logger->Hex(reinterpret_cast<unsigned char*>(readBuffer), readBufferLength);
+		logger->Received(reinterpret_cast<unsigned char*>(readBuffer), readBufferLength);
 	}
 
 	void Ecos::Parser()
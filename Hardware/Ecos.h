@@ -33,6 +33,11 @@ namespace Hardware
 			Ecos(const HardwareParams* params);
 			~Ecos();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
@@ -25,9 +25,11 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/Loco.h"
 #include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
+#include "Languages.h"
 #include "Logger/Logger.h"
 #include "Hardware/CS2Udp.h"
 #include "Hardware/CS2Tcp.h"
+#include "Hardware/CS2Replay.h"
 #include "Hardware/CcSchnitte.h"
 #include "Hardware/Ecos.h"
 #include "Hardware/HardwareHandler.h"
@@ -35,6 +37,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/M6051.h"
 #include "Hardware/OpenDcc.h"
 #include "Hardware/RM485.h"
+#include "Hardware/Simulation.h"
 #include "Hardware/Virtual.h"
 #include "Hardware/Z21.h"
 #include "Utils/Utils.h"
@@ -55,7 +58,27 @@ namespace Hardware
 		"Z21",
 		"CcSchnitte",
 		"Ecos",
-		"CS2Tcp"
+		"CS2Tcp",
+		"CS2Replay",
+		"Simulation"
+	};
+
+	// the limits are chosen to not overflow the buffers of the command stations
+	const HardwareHandler::CommandRate HardwareHandler::commandRates[] =
+	{
+		{ 0, 1, false }, // none
+		{ 0, 1, false }, // Virtual
+		{ 100, 10, false }, // CS2Udp
+		{ 40, 1, false }, // M6051
+		{ 0, 1, false }, // RM485
+		{ 50, 4, true }, // OpenDcc
+		{ 0, 1, false }, // Hsi88
+		{ 50, 10, true }, // Z21
+		{ 40, 1, false }, // CcSchnitte (Märklin Gleisbox)
+		{ 100, 10, false }, // Ecos
+		{ 100, 10, false }, // CS2Tcp
+		{ 0, 1, false }, // CS2Replay
+		{ 0, 1, false } // Simulation
 	};
 
 	void HardwareHandler::Init(const HardwareParams* params)
@@ -75,11 +98,21 @@ namespace Hardware
 				destroyHardware = (void (*)(Hardware::HardwareInterface*))(&destroy_CS2Tcp);
 				break;
 
+			case HardwareTypeCS2Replay:
+				createHardware = (Hardware::HardwareInterface* (*)(const Hardware::HardwareParams*))(&create_CS2Replay);
+				destroyHardware = (void (*)(Hardware::HardwareInterface*))(&destroy_CS2Replay);
+				break;
+
 			case HardwareTypeVirtual:
 				createHardware = (Hardware::HardwareInterface* (*)(const Hardware::HardwareParams*))(&create_Virtual);
 				destroyHardware = (void (*)(Hardware::HardwareInterface*))(&destroy_Virtual);
 				break;
 
+			case HardwareTypeSimulation:
+				createHardware = (Hardware::HardwareInterface* (*)(const Hardware::HardwareParams*))(&create_Simulation);
+				destroyHardware = (void (*)(Hardware::HardwareInterface*))(&destroy_Simulation);
+				break;
+
 
 			case HardwareTypeM6051:
 				createHardware = (Hardware::HardwareInterface* (*)(const Hardware::HardwareParams*))(&create_M6051);
@@ -123,14 +156,28 @@ namespace Hardware
 		}
 
 		// start control
-		if (createHardware != nullptr)
+		if (createHardware == nullptr)
 		{
-			instance = createHardware(params);
+			return;
 		}
+		instance = createHardware(params);
+		// the table is indexed by the hardware type, a new hardware type needs its own entry
+		static_assert(sizeof(commandRates) / sizeof(commandRates[0]) == HardwareTypeNumbers, "commandRates needs one entry per HardwareType");
+		const CommandRate& commandRate = commandRates[type];
+		locoBatched = commandRate.locoBatched;
+		commandQueue.Start(hardwareSymbols[type], commandRate.rate, commandRate.burst);
 	}
 
 	void HardwareHandler::Close()
 	{
+		// the queued commands and the pending accessory pulses still use the instance
+		commandQueue.Terminate();
+		if (instance != nullptr)
+		{
+			params->GetManager()->GetTimer().RunPending(instance);
+			const CommandQueue::Statistics statistics = commandQueue.GetStatistics();
+			instance->GetLogger()->Info(Languages::TextCommandStatistics, statistics.sent, statistics.superseded, statistics.immediately);
+		}
 		Hardware::HardwareInterface* instanceTemp = instance;
 		instance = nullptr;
 		createHardware = nullptr;
@@ -142,6 +189,19 @@ namespace Hardware
 		params = nullptr;
 	}
 
+	bool HardwareHandler::CommandStatistics(unsigned int& sent, unsigned int& superseded, unsigned int& immediately)
+	{
+		if (instance == nullptr)
+		{
+			return false;
+		}
+		const CommandQueue::Statistics statistics = commandQueue.GetStatistics();
+		sent = statistics.sent;
+		superseded = statistics.superseded;
+		immediately = statistics.immediately;
+		return true;
+	}
+
 	const std::string HardwareHandler::GetName() const
 	{
 		if (instance == nullptr)
@@ -207,7 +267,9 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Booster(status);
+		// the booster is switched immediately, it must not wait behind queued loco commands
+		Hardware::HardwareInterface* hardware = instance;
+		commandQueue.SendImmediately([=]() { hardware->Booster(status); });
 	}
 
 	void HardwareHandler::LocoSpeed(const ControlType controlType, const DataModel::Loco* loco, const Speed speed)
@@ -216,7 +278,25 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoSpeed(loco->GetProtocol(), loco->GetAddress(), speed);
+		Hardware::HardwareInterface* hardware = instance;
+		const Protocol protocol = loco->GetProtocol();
+		const Address address = loco->GetAddress();
+		const CommandQueue::Key key = LocoCommandKey(CommandKindLocoSpeed, protocol, address);
+		if (speed == MinSpeed)
+		{
+			// a queued loco state would send the old speed again after the stop
+			const bool stateDropped = locoBatched && commandQueue.Drop(LocoCommandKey(CommandKindLocoState, protocol, address));
+			// stopping a loco must not wait behind other commands
+			commandQueue.SendImmediately([=]() { hardware->LocoSpeed(protocol, address, speed); }, key);
+			if (stateDropped)
+			{
+				// orientation and functions of the dropped state still have to be sent
+				std::vector<DataModel::LocoFunctionEntry> functions = loco->GetFunctionStates();
+				EnqueueLocoState(protocol, address, speed, loco->GetOrientation(), functions);
+			}
+			return;
+		}
+		commandQueue.Enqueue([=]() { hardware->LocoSpeed(protocol, address, speed); }, 1, key);
 	}
 
 	void HardwareHandler::LocoOrientation(const ControlType controlType, const DataModel::Loco* loco, const Orientation orientation)
@@ -225,7 +305,10 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoOrientation(loco->GetProtocol(), loco->GetAddress(), orientation);
+		Hardware::HardwareInterface* hardware = instance;
+		const Protocol protocol = loco->GetProtocol();
+		const Address address = loco->GetAddress();
+		commandQueue.Enqueue([=]() { hardware->LocoOrientation(protocol, address, orientation); }, 1, LocoCommandKey(CommandKindLocoOrientation, protocol, address));
 	}
 
 	void HardwareHandler::LocoFunction(const ControlType controlType,
@@ -237,7 +320,10 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoFunction(loco->GetProtocol(), loco->GetAddress(), function, on);
+		Hardware::HardwareInterface* hardware = instance;
+		const Protocol protocol = loco->GetProtocol();
+		const Address address = loco->GetAddress();
+		commandQueue.Enqueue([=]() { hardware->LocoFunction(protocol, address, function, on); }, 1, LocoCommandKey(CommandKindLocoFunction, protocol, address, function));
 	}
 
 	void HardwareHandler::LocoSpeedOrientationFunctions(const DataModel::Loco* loco,
@@ -249,7 +335,41 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->LocoSpeedOrientationFunctions(loco->GetProtocol(), loco->GetAddress(), speed, orientation, functions);
+		Hardware::HardwareInterface* hardware = instance;
+		const Protocol protocol = loco->GetProtocol();
+		const Address address = loco->GetAddress();
+		if (hardware->IsLocoStateCached(protocol, address, speed, orientation, functions))
+		{
+			// the command station already knows this state
+			return;
+		}
+		if (locoBatched)
+		{
+			EnqueueLocoState(protocol, address, speed, orientation, functions);
+			return;
+		}
+
+		// every command is rate limited on its own
+		commandQueue.Enqueue([=]() { hardware->LocoSpeed(protocol, address, speed); }, 1, LocoCommandKey(CommandKindLocoSpeed, protocol, address));
+		commandQueue.Enqueue([=]() { hardware->LocoOrientation(protocol, address, orientation); }, 1, LocoCommandKey(CommandKindLocoOrientation, protocol, address));
+		for (const DataModel::LocoFunctionEntry& functionEntry : functions)
+		{
+			const DataModel::LocoFunctionNr function = functionEntry.nr;
+			const DataModel::LocoFunctionState on = functionEntry.state;
+			commandQueue.Enqueue([=]() { hardware->LocoFunction(protocol, address, function, on); }, 1, LocoCommandKey(CommandKindLocoFunction, protocol, address, function));
+		}
+	}
+
+	void HardwareHandler::EnqueueLocoState(const Protocol protocol,
+		const Address address,
+		const Speed speed,
+		const Orientation orientation,
+		std::vector<DataModel::LocoFunctionEntry>& functions)
+	{
+		Hardware::HardwareInterface* hardware = instance;
+		commandQueue.Enqueue([=]() mutable { hardware->LocoSpeedOrientationFunctions(protocol, address, speed, orientation, functions); },
+			1 + functions.size(),
+			LocoCommandKey(CommandKindLocoState, protocol, address));
 	}
 
 	void HardwareHandler::AccessoryState(const ControlType controlType, const DataModel::Accessory* accessory)
@@ -261,7 +381,7 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Accessory(accessory->GetProtocol(), accessory->GetAddress(), accessory->GetInvertedAccessoryState(), accessory->GetAccessoryPulseDuration());
+		Accessory(accessory->GetProtocol(), accessory->GetAddress(), accessory->GetInvertedAccessoryState(), accessory->GetAccessoryPulseDuration());
 	}
 
 	void HardwareHandler::SwitchState(const ControlType controlType, const DataModel::Switch* mySwitch)
@@ -282,18 +402,18 @@ namespace Hardware
 			switch (mySwitch->GetAccessoryState())
 			{
 				case DataModel::SwitchStateTurnout:
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
 					break;
 
 				case DataModel::SwitchStateStraight:
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
 					break;
 
 				case DataModel::SwitchStateThird:
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
 					break;
 
 				default:
@@ -302,7 +422,13 @@ namespace Hardware
 			return;
 		}
 		// else left or right switch
-		instance->Accessory(protocol, address, mySwitch->GetInvertedAccessoryState(), duration);
+		Accessory(protocol, address, mySwitch->GetInvertedAccessoryState(), duration);
+	}
+
+	void HardwareHandler::Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
+	{
+		Hardware::HardwareInterface* hardware = instance;
+		commandQueue.Enqueue([=]() { hardware->Accessory(protocol, address, state, duration); });
 	}
 
 	void HardwareHandler::SignalState(const ControlType controlType, const DataModel::Signal* signal)
@@ -314,7 +440,7 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Accessory(signal->GetProtocol(), signal->GetAddress(), signal->GetInvertedAccessoryState(), signal->GetAccessoryPulseDuration());
+		Accessory(signal->GetProtocol(), signal->GetAddress(), signal->GetInvertedAccessoryState(), signal->GetAccessoryPulseDuration());
 	}
 
 	bool HardwareHandler::ProgramCheckValues(const ProgramMode mode, const CvNumber cv, const CvValue value)
@@ -362,7 +488,8 @@ namespace Hardware
 			return;
 		}
 
-		instance->ProgramRead(mode, address, cv);
+		Hardware::HardwareInterface* hardware = instance;
+		commandQueue.Enqueue([=]() { hardware->ProgramRead(mode, address, cv); });
 	}
 
 	void HardwareHandler::ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value)
@@ -375,7 +502,8 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->ProgramWrite(mode, address, cv, value);
+		Hardware::HardwareInterface* hardware = instance;
+		commandQueue.Enqueue([=]() { hardware->ProgramWrite(mode, address, cv, value); });
 	}
 
 	void HardwareHandler::ArgumentTypesOfHardwareTypeAndHint(const HardwareType hardwareType, std::map<unsigned char,ArgumentType>& arguments, std::string& hint)
@@ -390,6 +518,10 @@ namespace Hardware
 				Hardware::CS2Tcp::GetArgumentTypesAndHint(arguments, hint);
 				return;
 
+			case HardwareTypeCS2Replay:
+				Hardware::CS2Replay::GetArgumentTypesAndHint(arguments, hint);
+				return;
+
 			case HardwareTypeM6051:
 				Hardware::M6051::GetArgumentTypesAndHint(arguments, hint);
 				return;
@@ -418,6 +550,10 @@ namespace Hardware
 				Hardware::Ecos::GetArgumentTypesAndHint(arguments, hint);
 				return;
 
+			case HardwareTypeSimulation:
+				Hardware::Simulation::GetArgumentTypesAndHint(arguments, hint);
+				return;
+
 			case HardwareTypeVirtual:
 				Hardware::Virtual::GetHint(hint);
 				return;
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "ControlInterface.h"
 #include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
+#include "Hardware/CommandQueue.h"
 #include "Hardware/HardwareInterface.h"
 #include "Hardware/HardwareParams.h"
 #include "Manager.h"
@@ -43,7 +44,8 @@ namespace Hardware
 				createHardware(nullptr),
 				destroyHardware(nullptr),
 				instance(nullptr),
-				params(nullptr)
+				params(nullptr),
+				locoBatched(false)
 			{
 				Init(params);
 			}
@@ -89,17 +91,62 @@ namespace Hardware
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
 
+			inline unsigned int PendingCommands() override
+			{
+				return commandQueue.Pending();
+			}
+
+			bool CommandStatistics(unsigned int& sent, unsigned int& superseded, unsigned int& immediately) override;
+
 			static void ArgumentTypesOfHardwareTypeAndHint(const HardwareType hardwareType, std::map<unsigned char,ArgumentType>& arguments, std::string& hint);
 
 		private:
+			struct CommandRate
+			{
+				// commands per second, 0 means unlimited
+				unsigned int rate;
+				unsigned int burst;
+				// the hardware packs speed, orientation and functions of a loco into fewer commands
+				bool locoBatched;
+			};
+
+			enum CommandKind : uint8_t
+			{
+				CommandKindLocoSpeed = 1,
+				CommandKindLocoOrientation,
+				CommandKindLocoFunction,
+				CommandKindLocoState
+			};
+
+			// a queued loco command is superseded by a newer one of the same kind for the same loco
+			static inline CommandQueue::Key LocoCommandKey(const CommandKind kind,
+				const Protocol protocol,
+				const Address address,
+				const DataModel::LocoFunctionNr function = 0)
+			{
+				return (static_cast<CommandQueue::Key>(kind) << 32)
+					| (static_cast<CommandQueue::Key>(protocol) << 24)
+					| (static_cast<CommandQueue::Key>(function) << 16)
+					| address;
+			}
+
 			createHardware_t* createHardware;
 			destroyHardware_t* destroyHardware;
 			Hardware::HardwareInterface* instance;
 			const HardwareParams* params;
+			bool locoBatched;
+			CommandQueue commandQueue;
 
 			static const std::string hardwareSymbols[];
+			static const CommandRate commandRates[];
 
 			void Init(const HardwareParams* params);
+			void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration);
+			void EnqueueLocoState(const Protocol protocol,
+				const Address address,
+				const Speed speed,
+				const Orientation orientation,
+				std::vector<DataModel::LocoFunctionEntry>& functions);
 			void Close();
 			bool ProgramCheckValues(const ProgramMode mode, const CvNumber cv, const CvValue value = 1);
 	};
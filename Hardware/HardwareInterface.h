@@ -49,6 +49,9 @@ namespace Hardware
 			// get the name of the hardware
 			const std::string GetName() const { return name; }
 
+			// get the logger of the hardware
+			virtual Logger::Logger* GetLogger() const = 0;
+
 			// get hardware capabilities
 			virtual Hardware::Capabilities GetCapabilities() const = 0;
 
@@ -87,23 +90,35 @@ namespace Hardware
 				const Orientation orientation,
 				std::vector<DataModel::LocoFunctionEntry>& functions)
 			{
-				// sleeps are necessary to prevent command overflow in command stations (especially Märklin Gleisbox)
+				// the rate is limited by the command queue of the HardwareHandler
 				LocoSpeed(protocol, address, speed);
-				Utils::Utils::SleepForMilliseconds(25);
 				LocoOrientation(protocol, address, orientation);
-				Utils::Utils::SleepForMilliseconds(25);
 				for (const DataModel::LocoFunctionEntry& functionEntry : functions)
 				{
 					LocoFunction(protocol, address, functionEntry.nr, functionEntry.state);
-					Utils::Utils::SleepForMilliseconds(25);
 				}
 			}
 
+			// has the command station reported or been sent exactly this loco state
+			virtual bool IsLocoStateCached(__attribute__((unused)) const Protocol protocol,
+				__attribute__((unused)) const Address address,
+				__attribute__((unused)) const Speed speed,
+				__attribute__((unused)) const Orientation orientation,
+				__attribute__((unused)) const std::vector<DataModel::LocoFunctionEntry>& functions)
+			{
+				return false;
+			}
+
 			// accessory command
+			// the output is switched off by the timer of the manager, so pulses to different decoders overlap
 			virtual void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
 			{
+				// a pulse still running on the same decoder is finished first
+				const Timer::Key key = (static_cast<Timer::Key>(protocol) << 16) | address;
+				Timer& timer = manager->GetTimer();
+				timer.RunPending(this, key);
 				AccessoryOnOrOff(protocol, address, state, true);
-				std::async(std::launch::async, AccessoryOnOrOffStatic, this, protocol, address, state, duration);
+				timer.Schedule(this, key, std::chrono::milliseconds(duration), [=]() { AccessoryOnOrOff(protocol, address, state, false); });
 			};
 
 			// read CV value
@@ -118,13 +133,6 @@ namespace Hardware
 			const std::string name;
 
 			virtual void AccessoryOnOrOff(__attribute__((unused)) const Protocol protocol, __attribute__((unused)) const Address address, __attribute__((unused)) const DataModel::AccessoryState state, __attribute__((unused)) const bool on) {}
-
-		private:
-			static void AccessoryOnOrOffStatic(HardwareInterface* hardware, const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
-			{
-				Utils::Utils::SleepForMilliseconds(duration);
-				hardware->AccessoryOnOrOff(protocol, address, state, false);
-			}
 	};
 
 } // namespace
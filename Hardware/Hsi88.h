@@ -36,6 +36,11 @@ namespace Hardware
 			Hsi88(const HardwareParams* params);
 			~Hsi88();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityFeedback;
@@ -23,6 +23,8 @@ along with RailControl; see the file LICENCE. If not see
 #include <cstring>
 #include <string>
 #include <map>
+#include <mutex>
+#include <vector>
 
 #include "DataTypes.h"
 #include "DataModel/LocoFunctions.h"
@@ -175,8 +177,101 @@ namespace Hardware
 				entries.erase(name);
 			}
 
+			// the state of the locos is stored by their local ID on the CAN bus,
+			// it is set by the commands sent and received
+			inline void SetSpeed(const uint32_t localID, const Speed speed)
+			{
+				std::lock_guard<std::mutex> guard(statesMutex);
+				LocoState& state = states[localID];
+				state.speed = speed;
+				state.speedKnown = true;
+			}
+
+			inline void SetOrientation(const uint32_t localID, const Orientation orientation)
+			{
+				std::lock_guard<std::mutex> guard(statesMutex);
+				LocoState& state = states[localID];
+				state.orientation = orientation;
+				state.orientationKnown = true;
+				// changing orientation implies speed = 0
+				state.speed = MinSpeed;
+				state.speedKnown = true;
+			}
+
+			inline void SetFunction(const uint32_t localID, const DataModel::LocoFunctionNr nr, const DataModel::LocoFunctionState on)
+			{
+				if (nr >= 64)
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> guard(statesMutex);
+				LocoState& state = states[localID];
+				const uint64_t mask = static_cast<uint64_t>(1) << nr;
+				state.functionsKnown |= mask;
+				if (on == DataModel::LocoFunctionStateOn)
+				{
+					state.functions |= mask;
+				}
+				else
+				{
+					state.functions &= ~mask;
+				}
+			}
+
+			inline bool IsState(const uint32_t localID,
+				const Speed speed,
+				const Orientation orientation,
+				const std::vector<DataModel::LocoFunctionEntry>& functions)
+			{
+				std::lock_guard<std::mutex> guard(statesMutex);
+				auto entry = states.find(localID);
+				if (entry == states.end())
+				{
+					return false;
+				}
+				const LocoState& state = entry->second;
+				if (!state.speedKnown || state.speed != speed || !state.orientationKnown || state.orientation != orientation)
+				{
+					return false;
+				}
+				for (const DataModel::LocoFunctionEntry& function : functions)
+				{
+					if (function.nr >= 64)
+					{
+						return false;
+					}
+					const uint64_t mask = static_cast<uint64_t>(1) << function.nr;
+					if ((state.functionsKnown & mask) == 0 || ((state.functions & mask) != 0) != (function.state == DataModel::LocoFunctionStateOn))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
 		private:
+			struct LocoState
+			{
+				LocoState()
+				:	speed(MinSpeed),
+					speedKnown(false),
+					orientation(OrientationRight),
+					orientationKnown(false),
+					functions(0),
+					functionsKnown(0)
+				{}
+
+				Speed speed;
+				bool speedKnown;
+				Orientation orientation;
+				bool orientationKnown;
+				uint64_t functions;
+				uint64_t functionsKnown;
+			};
+
 			std::map<std::string,LocoCacheEntry> entries;
+			std::map<uint32_t,LocoState> states;
+			std::mutex statesMutex;
 	};
 } // namespace Hardware
 
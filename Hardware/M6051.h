@@ -35,6 +35,11 @@ namespace Hardware
 			M6051(const HardwareParams* params);
 			~M6051();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
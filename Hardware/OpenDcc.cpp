@@ -249,6 +249,7 @@ namespace Hardware
 		const unsigned char addressMSB = (address >> 8);
 		const unsigned char data[5] = { XLok, addressLSB, addressMSB, entry.speed, entry.orientationF0 };
 
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		unsigned char input;
 		bool ret = serialLine.ReceiveExact(&input, 1);
@@ -257,6 +258,7 @@ namespace Hardware
 			logger->Warning(Languages::TextControlDoesNotAnswer);
 			return false;
 		}
+		logger->Received(&input, 1);
 		switch (input)
 		{
 			case OK:
@@ -287,6 +289,7 @@ namespace Hardware
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
 		const unsigned char data[4] = { XFunc, addressLSB, addressMSB, entry.function[0] };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		return ReceiveFunctionCommandAnswer();
 	}
@@ -298,6 +301,7 @@ namespace Hardware
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
 		const unsigned char data[4] = { XFunc2, addressLSB, addressMSB, entry.function[1] };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		return ReceiveFunctionCommandAnswer();
 	}
@@ -309,6 +313,7 @@ namespace Hardware
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
 		const unsigned char data[5] = { XFunc34, addressLSB, addressMSB, entry.function[2], entry.function[3] };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		return ReceiveFunctionCommandAnswer();
 	}
@@ -322,6 +327,7 @@ namespace Hardware
 			logger->Warning(Languages::TextControlDoesNotAnswer);
 			return false;
 		}
+		logger->Received(&input, 1);
 		switch (input)
 		{
 			case OK:
@@ -353,6 +359,7 @@ namespace Hardware
 		const unsigned char statusBits = ((state == DataModel::AccessoryStateOn) << 7) | (on << 6);
 		const unsigned char addressStatus = addressMSB | statusBits;
 		const unsigned char data[3] = { XTrnt, addressLSB, addressStatus };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		unsigned char input;
 		bool ret = serialLine.ReceiveExact(&input, 1);
@@ -361,6 +368,7 @@ namespace Hardware
 			logger->Warning(Languages::TextControlDoesNotAnswer);
 			return;
 		}
+		logger->Received(&input, 1);
 		switch (input)
 		{
 			case OK:
@@ -383,24 +391,35 @@ namespace Hardware
 	bool OpenDcc::SendP50XOnly() const
 	{
 		unsigned char data[6] = { 'X', 'Z', 'Z', 'A', '1', 0x0D };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		std::string input;
-		serialLine.ReceiveExact(input, 34);
+		if (serialLine.ReceiveExact(input, 34))
+		{
+			logger->Received(input);
+		}
 		return true;
 	}
 
 	bool OpenDcc::SendOneByteCommand(const unsigned char data) const
 	{
+		logger->Sent(&data, 1);
 		serialLine.Send(data);
 		unsigned char input[1];
 		int ret = serialLine.Receive(input, sizeof(input));
-		return ret > 0 && input[0] == OK;
+		if (ret <= 0)
+		{
+			return false;
+		}
+		logger->Received(input, ret);
+		return input[0] == OK;
 	}
 
 	bool OpenDcc::SendRestart() const
 	{
 		unsigned char data[3] = { '@', '@', 0x0D };
 		logger->Info(Languages::TextRestarting);
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		return true;
 	}
@@ -408,10 +427,16 @@ namespace Hardware
 	unsigned char OpenDcc::SendXP88Get(unsigned char param) const
 	{
 		unsigned char data[2] = { XP88Get, param };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		unsigned char input;
 		size_t ret = serialLine.ReceiveExact(&input, 1);
-		if (ret == 0 || input != OK)
+		if (ret == 0)
+		{
+			return 0xFF;
+		}
+		logger->Received(&input, 1);
+		if (input != OK)
 		{
 			return 0xFF;
 		}
@@ -420,12 +445,14 @@ namespace Hardware
 		{
 			return 0xFF;
 		}
+		logger->Received(&input, 1);
 		return input;
 	}
 
 	bool OpenDcc::SendXP88Set(unsigned char param, unsigned char value) const
 	{
 		unsigned char data[3] = { XP88Set, param, value };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		unsigned char input;
 		size_t ret = serialLine.ReceiveExact(&input, 1);
@@ -433,6 +460,7 @@ namespace Hardware
 		{
 			return false;
 		}
+		logger->Received(&input, 1);
 		return (input == OK);
 	}
 
@@ -456,12 +484,18 @@ namespace Hardware
 	void OpenDcc::SendXEvtSen() const
 	{
 		unsigned char data[1] = { XEvtSen };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		while (true)
 		{
 			unsigned char module;
 			size_t ret = serialLine.ReceiveExact(&module, 1);
-			if (ret == 0 || module == 0)
+			if (ret == 0)
+			{
+				return;
+			}
+			logger->Received(&module, 1);
+			if (module == 0)
 			{
 				return;
 			}
@@ -475,6 +509,7 @@ namespace Hardware
 			{
 				return;
 			}
+			logger->Received(data, sizeof(data));
 
 			if (s88Memory[module] != data[0])
 			{
@@ -493,6 +528,7 @@ namespace Hardware
 	void OpenDcc::SendXEvent() const
 	{
 		unsigned char data[1] = { XEvent };
+		logger->Sent(data, sizeof(data));
 		serialLine.Send(data, sizeof(data));
 		unsigned char input;
 		size_t ret = serialLine.ReceiveExact(&input, 1);
@@ -500,6 +536,7 @@ namespace Hardware
 		{
 			return;
 		}
+		logger->Received(&input, 1);
 		bool locoEvent = input & 0x01;
 		bool sensorEvent = (input >> 2) & 0x01;
 		bool powerEvent = (input >> 3) & 0x01;
@@ -517,6 +554,7 @@ namespace Hardware
 			{
 				break;
 			}
+			logger->Received(&input, 1);
 		}
 
 		if (sensorEvent)
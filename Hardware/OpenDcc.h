@@ -36,6 +36,11 @@ namespace Hardware
 			OpenDcc(const HardwareParams* params);
 			~OpenDcc();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
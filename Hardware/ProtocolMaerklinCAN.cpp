@@ -148,6 +148,11 @@ namespace Hardware
 	}
 
 	void ProtocolMaerklinCAN::CreateLocalIDLoco(unsigned char* buffer, const Protocol& protocol, const Address& address)
+	{
+		Utils::Utils::IntToDataBigEndian(LocalIDLoco(protocol, address), buffer + 5);
+	}
+
+	uint32_t ProtocolMaerklinCAN::LocalIDLoco(const Protocol protocol, const Address address)
 	{
 		uint32_t localID = address;
 		if (protocol == ProtocolDCC)
@@ -159,7 +164,7 @@ namespace Hardware
 			localID |= 0x4000;
 		}
 		// else expect PROTOCOL_MM2: do nothing
-		Utils::Utils::IntToDataBigEndian(localID, buffer + 5);
+		return localID;
 	}
 
 	void ProtocolMaerklinCAN::CreateLocalIDAccessory(unsigned char* buffer, const Protocol& protocol, const Address& address)
@@ -193,6 +198,7 @@ namespace Hardware
 		CreateLocalIDLoco(buffer, protocol, address);
 		Utils::Utils::ShortToDataBigEndian(speed, buffer + 9);
 		SendInternal(buffer);
+		locoCache.SetSpeed(LocalIDLoco(protocol, address), speed);
 	}
 
 	void ProtocolMaerklinCAN::LocoOrientation(const Protocol protocol, const Address address, const Orientation orientation)
@@ -203,6 +209,7 @@ namespace Hardware
 		CreateLocalIDLoco(buffer, protocol, address);
 		buffer[9] = (orientation ? 1 : 2);
 		SendInternal(buffer);
+		locoCache.SetOrientation(LocalIDLoco(protocol, address), orientation);
 	}
 
 	void ProtocolMaerklinCAN::LocoFunction(const Protocol protocol,
@@ -217,6 +224,7 @@ namespace Hardware
 		buffer[9] = function;
 		buffer[10] = (on == DataModel::LocoFunctionStateOn);
 		SendInternal(buffer);
+		locoCache.SetFunction(LocalIDLoco(protocol, address), function, on);
 	}
 
 	void ProtocolMaerklinCAN::AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on)
@@ -333,7 +341,7 @@ namespace Hardware
 		CanResponse response = ParseResponse(buffer);
 		CanCommand command = ParseCommand(buffer);
 		CanLength length = ParseLength(buffer);
-		logger->Hex(buffer, 5 + length);
+		logger->Received(buffer, 5 + length);
 		const CanHash receivedHash = ParseHash(buffer);
 		if (receivedHash == hash)
 		{
@@ -439,6 +447,7 @@ namespace Hardware
 		ParseAddressProtocol(buffer, address, protocol);
 		Speed speed = Utils::Utils::DataBigEndianToShort(buffer + 9);
 		logger->Info(Languages::TextReceivedSpeedCommand, protocol, address, speed);
+		locoCache.SetSpeed(ParseAddress(buffer), speed);
 		manager->LocoSpeed(ControlTypeHardware, controlID, protocol, address, speed);
 	}
 
@@ -453,6 +462,7 @@ namespace Hardware
 		ParseAddressProtocol(buffer, address, protocol);
 		Orientation orientation = (buffer[9] == 1 ? OrientationRight : OrientationLeft);
 		logger->Info(Languages::TextReceivedDirectionCommand, protocol, address, orientation);
+		locoCache.SetOrientation(ParseAddress(buffer), orientation);
 		// changing direction implies speed = 0
 		manager->LocoSpeed(ControlTypeHardware, controlID, protocol, address, MinSpeed);
 		manager->LocoOrientation(ControlTypeHardware, controlID, protocol, address, orientation);
@@ -470,6 +480,7 @@ namespace Hardware
 		DataModel::LocoFunctionNr function = buffer[9];
 		DataModel::LocoFunctionState on = (buffer[10] != 0 ? DataModel::LocoFunctionStateOn : DataModel::LocoFunctionStateOff);
 		logger->Info(Languages::TextReceivedFunctionCommand, protocol, address, function, on);
+		locoCache.SetFunction(ParseAddress(buffer), function, on);
 		manager->LocoFunctionState(ControlTypeHardware, controlID, protocol, address, function, on);
 	}
 
@@ -38,6 +38,11 @@ namespace Hardware
 		public:
 			ProtocolMaerklinCAN() = delete;
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
@@ -84,6 +89,15 @@ namespace Hardware
 				const DataModel::LocoFunctionNr function,
 				const DataModel::LocoFunctionState on) override;
 
+			bool IsLocoStateCached(const Protocol protocol,
+				const Address address,
+				const Speed speed,
+				const Orientation orientation,
+				const std::vector<DataModel::LocoFunctionEntry>& functions) override
+			{
+				return locoCache.IsState(LocalIDLoco(protocol, address), speed, orientation, functions);
+			}
+
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
@@ -128,7 +142,6 @@ namespace Hardware
 			Logger::Logger* logger;
 			volatile bool run;
 
-		private:
 			enum CanCommand : unsigned char
 			{
 				CanCommandSystem = 0x00,
@@ -145,18 +158,29 @@ namespace Hardware
 				CanCommandHello = 0x42
 			};
 
-			enum CanSubCommand : unsigned char
-			{
-				CanSubCommandStop = 0x00,
-				CanSubCommandGo = 0x01
-			};
-
 			enum CanResponse : unsigned char
 			{
 				CanResponseCommand = 0x00,
 				CanResponseResponse = 0x01
 			};
 
+			static inline CanCommand ParseCommand(const unsigned char* const buffer)
+			{
+				return static_cast<CanCommand>((buffer[0] << 7) | (buffer[1] >> 1));
+			}
+
+			static inline CanResponse ParseResponse(const unsigned char* const buffer)
+			{
+				return static_cast<CanResponse>(buffer[1] & 0x01);
+			}
+
+		private:
+			enum CanSubCommand : unsigned char
+			{
+				CanSubCommandStop = 0x00,
+				CanSubCommandGo = 0x01
+			};
+
 			enum CanDeviceType : uint16_t
 			{
 				CanDeviceGfp = 0x0000,
@@ -296,21 +320,11 @@ namespace Hardware
 				return buffer[0] >> 1;
 			}
 
-			static inline CanCommand ParseCommand(const unsigned char* const buffer)
-			{
-				return static_cast<CanCommand>((buffer[0] << 7) | (buffer[1] >> 1));
-			}
-
 			static inline CanSubCommand ParseSubCommand(const unsigned char* const buffer)
 			{
 				return static_cast<CanSubCommand>(buffer[9]);
 			}
 
-			static inline CanResponse ParseResponse(const unsigned char* const buffer)
-			{
-				return static_cast<CanResponse>(buffer[1] & 0x01);
-			}
-
 			static inline CanLength ParseLength(const unsigned char* const buffer)
 			{
 				return buffer[4];
@@ -361,6 +375,7 @@ namespace Hardware
 			static CanHash CalcHash(const CanUid uid);
 			void GenerateUidHash();
 
+			static uint32_t LocalIDLoco(const Protocol protocol, const Address address);
 			void CreateLocalIDLoco(unsigned char* buffer, const Protocol& protocol, const Address& address);
 			void CreateLocalIDAccessory(unsigned char* buffer, const Protocol& protocol, const Address& address);
 
@@ -369,7 +384,7 @@ namespace Hardware
 
 			inline void SendInternal(const unsigned char* buffer)
 			{
-				logger->Hex(buffer, 5 + ParseLength(buffer));
+				logger->Sent(buffer, 5 + ParseLength(buffer));
 				Send(buffer);
 			}
 			virtual void Send(const unsigned char* buffer) = 0;
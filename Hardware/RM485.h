@@ -99,6 +99,11 @@ namespace Hardware
 			RM485(const HardwareParams* params);
 			~RM485();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityFeedback;
@@ -0,0 +1,259 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <vector>
+
+#include "DataModel/Loco.h"
+#include "Hardware/Simulation.h"
+#include "Manager.h"
+#include "Utils/Utils.h"
+
+using std::map;
+using std::vector;
+
+namespace Hardware
+{
+	const unsigned int Simulation::TickInterval;
+	const unsigned int Simulation::StatisticsInterval;
+	const int Simulation::DefaultSectionTime;
+	const int Simulation::MinSectionTime;
+	const int Simulation::MaxSectionTime;
+
+	extern "C" Simulation* create_Simulation(const HardwareParams* params)
+	{
+		return new Simulation(params);
+	}
+
+	extern "C" void destroy_Simulation(Simulation* simulation)
+	{
+		delete(simulation);
+	}
+
+	Simulation::Simulation(const HardwareParams* params)
+	:	HardwareInterface(params->GetManager(), params->GetControlID(), "Simulation / " + params->GetName()),
+	 	logger(Logger::Logger::GetLogger("Simulation " + params->GetName())),
+	 	run(true),
+	 	sectionDistance(static_cast<uint64_t>(SectionTime(params->GetArg1())) * MaxSpeed),
+	 	feedbacksReached(0),
+	 	reactions(0),
+	 	reactionTimeSum(0),
+	 	reactionTimeMax(0)
+	{
+		logger->Info(Languages::TextStarting, name);
+		simulatorThread = std::thread(&Hardware::Simulation::Simulator, this);
+	}
+
+	int Simulation::SectionTime(const std::string& value)
+	{
+		// an empty or invalid value must not make the simulation run faster than configured in the dialog
+		const int sectionTime = Utils::Utils::StringToInteger(value, DefaultSectionTime);
+		if (sectionTime < MinSectionTime)
+		{
+			return MinSectionTime;
+		}
+		if (sectionTime > MaxSectionTime)
+		{
+			return MaxSectionTime;
+		}
+		return sectionTime;
+	}
+
+	Simulation::~Simulation()
+	{
+		{
+			std::lock_guard<std::mutex> guard(locosMutex);
+			run = false;
+		}
+		runCondition.notify_one();
+		simulatorThread.join();
+	}
+
+	void Simulation::Booster(const BoosterState status)
+	{
+		logger->Info(status ? Languages::TextTurningBoosterOn : Languages::TextTurningBoosterOff);
+	}
+
+	void Simulation::LocoSpeed(const Protocol protocol, const Address address, const Speed speed)
+	{
+		// with hundreds of locos the commands are only of interest when debugging
+		logger->Debug(Languages::TextSettingSpeedWithProtocol, protocol, address, speed);
+		std::lock_guard<std::mutex> guard(locosMutex);
+		SimulatedLoco& loco = locos[address];
+		loco.speed = speed;
+		if (loco.reactionPending == false)
+		{
+			return;
+		}
+		loco.reactionPending = false;
+		const uint64_t reactionTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loco.feedbackTime).count();
+		++reactions;
+		reactionTimeSum += reactionTime;
+		if (reactionTime > reactionTimeMax)
+		{
+			reactionTimeMax = reactionTime;
+		}
+	}
+
+	void Simulation::LocoOrientation(const Protocol protocol, const Address address, const Orientation orientation)
+	{
+		logger->Debug(Languages::TextSettingDirectionOfTravelWithProtocol, protocol, address, Languages::GetLeftRight(orientation));
+	}
+
+	void Simulation::LocoFunction(const Protocol protocol,
+		const Address address,
+		const DataModel::LocoFunctionNr function,
+		const DataModel::LocoFunctionState on)
+	{
+		logger->Debug(Languages::TextSettingFunctionWithProtocol, static_cast<int>(function), static_cast<int>(protocol), address, Languages::GetOnOff(on));
+	}
+
+	void Simulation::AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on)
+	{
+		logger->Debug(Languages::TextSettingAccessoryWithProtocol, static_cast<int>(protocol), address, Languages::GetGreenRed(state), Languages::GetOnOff(on));
+	}
+
+	void Simulation::Move(const uint64_t elapsed, map<Address,FeedbackID>& locosReachingFeedback)
+	{
+		std::lock_guard<std::mutex> guard(locosMutex);
+		for (auto& entry : locos)
+		{
+			SimulatedLoco& loco = entry.second;
+			if (loco.speed == MinSpeed)
+			{
+				continue;
+			}
+			loco.distance += elapsed * loco.speed;
+			if (loco.distance < sectionDistance)
+			{
+				continue;
+			}
+			loco.distance = 0;
+			locosReachingFeedback[entry.first] = loco.lastFeedback;
+		}
+	}
+
+	void Simulation::ReachFeedback(const Address address, const FeedbackID lastFeedback)
+	{
+		// the manager and the loco must not be called with locosMutex locked,
+		// they call back into LocoSpeed while holding their own locks
+		DataModel::Loco* loco = manager->GetLoco(controlID, ProtocolNone, address);
+		if (loco == nullptr)
+		{
+			return;
+		}
+		vector<FeedbackID> expectedFeedbacks;
+		loco->GetExpectedFeedbacks(expectedFeedbacks);
+		if (expectedFeedbacks.size() == 0)
+		{
+			// loco is driven manually, there is no way to know where it is heading to
+			return;
+		}
+
+		// the next feedback is the one after the last reached or the first of the routes if the last one is already released
+		auto next = expectedFeedbacks.begin();
+		for (auto feedback = expectedFeedbacks.begin(); feedback != expectedFeedbacks.end(); ++feedback)
+		{
+			if (*feedback == lastFeedback)
+			{
+				next = feedback + 1;
+				break;
+			}
+		}
+		if (next == expectedFeedbacks.end())
+		{
+			// loco has reached the end of its routes and waits for the next one
+			return;
+		}
+		const FeedbackID nextFeedback = *next;
+
+		{
+			std::lock_guard<std::mutex> guard(locosMutex);
+			SimulatedLoco& simulatedLoco = locos[address];
+			simulatedLoco.lastFeedback = nextFeedback;
+			simulatedLoco.reactionPending = true;
+			simulatedLoco.feedbackTime = std::chrono::steady_clock::now();
+			++feedbacksReached;
+		}
+		manager->FeedbackState(nextFeedback, DataModel::Feedback::FeedbackStateOccupied);
+		if (lastFeedback != FeedbackNone)
+		{
+			// the loco has left the section of the last feedback
+			manager->FeedbackState(lastFeedback, DataModel::Feedback::FeedbackStateFree);
+		}
+	}
+
+	void Simulation::LogStatistics()
+	{
+		unsigned int running = 0;
+		std::lock_guard<std::mutex> guard(locosMutex);
+		for (auto& entry : locos)
+		{
+			if (entry.second.speed != MinSpeed)
+			{
+				++running;
+			}
+		}
+		if (running == 0 && feedbacksReached == 0)
+		{
+			return;
+		}
+		logger->Info(Languages::TextSimulationStatistics, running, locos.size(), feedbacksReached, reactions > 0 ? reactionTimeSum / reactions : 0, reactionTimeMax);
+		feedbacksReached = 0;
+		reactions = 0;
+		reactionTimeSum = 0;
+		reactionTimeMax = 0;
+	}
+
+	void Simulation::Simulator()
+	{
+		Utils::Utils::SetThreadName("Simulation");
+		std::chrono::steady_clock::time_point lastTick = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point nextStatistics = lastTick + std::chrono::seconds(StatisticsInterval);
+		map<Address,FeedbackID> locosReachingFeedback;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(locosMutex);
+				runCondition.wait_for(lock, std::chrono::milliseconds(TickInterval), [this] { return run == false; });
+				if (run == false)
+				{
+					return;
+				}
+			}
+
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			const uint64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastTick).count();
+			lastTick += std::chrono::milliseconds(elapsed);
+
+			locosReachingFeedback.clear();
+			Move(elapsed, locosReachingFeedback);
+			for (auto& loco : locosReachingFeedback)
+			{
+				ReachFeedback(loco.first, loco.second);
+			}
+
+			if (now >= nextStatistics)
+			{
+				LogStatistics();
+				nextStatistics += std::chrono::seconds(StatisticsInterval);
+			}
+		}
+	}
+} // namespace
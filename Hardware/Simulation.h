@@ -0,0 +1,122 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Hardware/HardwareInterface.h"
+#include "Hardware/HardwareParams.h"
+#include "Logger/Logger.h"
+
+namespace Hardware
+{
+	// command station that moves the locos along their reserved routes and reports the feedbacks they reach
+	// the locos of this control must use protocol none, the feedbacks may belong to any control
+	class Simulation : HardwareInterface
+	{
+		public:
+			Simulation(const HardwareParams* params);
+			~Simulation();
+
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
+			inline Hardware::Capabilities GetCapabilities() const override
+			{
+				return Hardware::CapabilityLoco
+					| Hardware::CapabilityAccessory
+					| Hardware::CapabilityFeedback;
+			}
+
+			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
+			{
+				argumentTypes[1] = ArgumentTypeSectionTime;
+				hint = Languages::GetText(Languages::TextHintSimulation);
+			}
+
+			void GetLocoProtocols(std::vector<Protocol>& protocols) const override { protocols.push_back(ProtocolNone); }
+			bool LocoProtocolSupported(const Protocol protocol) const override { return protocol == ProtocolNone; }
+			void GetAccessoryProtocols(std::vector<Protocol>& protocols) const override { protocols.push_back(ProtocolNone); }
+			bool AccessoryProtocolSupported(const Protocol protocol) const override { return protocol == ProtocolNone; }
+
+			void Booster(const BoosterState status) override;
+			void LocoSpeed(const Protocol protocol, const Address address, const Speed speed) override;
+			void LocoOrientation(const Protocol protocol, const Address address, const Orientation orientation) override;
+
+			void LocoFunction(const Protocol protocol,
+				const Address address,
+				const DataModel::LocoFunctionNr function,
+				const DataModel::LocoFunctionState on) override;
+
+			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
+
+		private:
+			struct SimulatedLoco
+			{
+				Speed speed;
+				// distance since the last feedback in milliseconds at maximum speed
+				uint64_t distance;
+				FeedbackID lastFeedback;
+				bool reactionPending;
+				std::chrono::steady_clock::time_point feedbackTime;
+			};
+
+			void Simulator();
+			// moves all running locos by elapsed milliseconds and collects the ones that reach their next feedback
+			void Move(const uint64_t elapsed, std::map<Address,FeedbackID>& locosReachingFeedback);
+			void ReachFeedback(const Address address, const FeedbackID lastFeedback);
+			void LogStatistics();
+
+			Logger::Logger* logger;
+			volatile bool run;
+			const uint64_t sectionDistance;
+			std::map<Address,SimulatedLoco> locos;
+			std::mutex locosMutex;
+			std::condition_variable runCondition;
+			std::thread simulatorThread;
+
+			// reset with every statistics output, locked with locosMutex
+			unsigned int feedbacksReached;
+			unsigned int reactions;
+			uint64_t reactionTimeSum;
+			uint64_t reactionTimeMax;
+
+			static const unsigned int TickInterval = 20; // milliseconds
+			static const unsigned int StatisticsInterval = 10; // seconds
+			// milliseconds per section at maximum speed, the default is the one of the edit dialog
+			static const int DefaultSectionTime = 2000;
+			static const int MinSectionTime = 10;
+			static const int MaxSectionTime = 60000;
+
+			static int SectionTime(const std::string& value);
+	};
+
+	extern "C" Simulation* create_Simulation(const HardwareParams* params);
+	extern "C" void destroy_Simulation(Simulation* simulation);
+
+} // namespace
@@ -34,6 +34,11 @@ namespace Hardware
 		public:
 			Virtual(const HardwareParams* params);
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
@@ -18,11 +18,14 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>    //int64_t;
 #include <cstdio>     //printf
 #include <cstdlib>    //exit(0);
 #include <cstring>    //memset
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -50,6 +53,7 @@ namespace Hardware
 	 	run(true),
 	 	connection(logger, params->GetArg1(), Z21Port),
 	 	lastProgramMode(ProgramModeMm),
+	 	maxEnergisedAccessories(params->GetArg2().empty() ? 4 : Utils::Utils::StringToInteger(params->GetArg2(), 1, 16)),
 	 	connected(false)
 	{
 		logger->Info(Languages::TextStarting, name);
@@ -70,10 +74,11 @@ namespace Hardware
 	Z21::~Z21()
 	{
 		run = false;
-		SendLogOff();
+		// the accessory sender switches off the outputs still energised, so the connection must still be open
 		accessoryQueue.Terminate();
-		connection.Terminate();
 		accessorySenderThread.join();
+		SendLogOff();
+		connection.Terminate();
 		heartBeatThread.join();
 		receiverThread.join();
 		logger->Info(Languages::TextTerminatingSenderSocket);
@@ -311,17 +316,53 @@ namespace Hardware
 	{
 		Utils::Utils::SetThreadName("Z21 Accessory Sender");
 		logger->Info(Languages::TextAccessorySenderThreadStarted);
+		// accessories switched on, with the time their output has to be switched off
+		std::map<Address,std::pair<AccessoryQueueEntry,std::chrono::steady_clock::time_point>> energised;
 		while (run)
 		{
-			AccessoryQueueEntry entry = accessoryQueue.Dequeue();
-			if (entry.protocol == ProtocolNone)
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			// the queue is checked at least every second to notice termination
+			std::chrono::steady_clock::time_point nextOff = now + std::chrono::seconds(1);
+			for (auto accessory = energised.begin(); accessory != energised.end(); )
+			{
+				const AccessoryQueueEntry& entry = accessory->second.first;
+				if (accessory->second.second <= now)
+				{
+					AccessoryOff(entry.protocol, entry.address, entry.state);
+					accessory = energised.erase(accessory);
+					continue;
+				}
+				nextOff = std::min(nextOff, accessory->second.second);
+				++accessory;
+			}
+
+			if (energised.size() >= maxEnergisedAccessories)
+			{
+				std::this_thread::sleep_until(nextOff);
+				continue;
+			}
+
+			AccessoryQueueEntry entry;
+			if (accessoryQueue.DequeueUntil(entry, nextOff) == false || entry.protocol == ProtocolNone)
 			{
 				// ProtocolNone is in queue when we should quit
 				continue;
 			}
+
+			// a decoder is never switched on twice at the same time
+			auto same = energised.find(entry.address);
+			if (same != energised.end())
+			{
+				AccessoryOff(same->second.first.protocol, same->second.first.address, same->second.first.state);
+				energised.erase(same);
+			}
 			SendSetTurnoutMode(entry.address, entry.protocol);
 			AccessoryOn(entry.protocol, entry.address, entry.state);
-			Utils::Utils::SleepForMilliseconds(entry.duration);
+			energised[entry.address] = std::make_pair(entry, std::chrono::steady_clock::now() + std::chrono::milliseconds(entry.duration));
+		}
+		for (auto& accessory : energised)
+		{
+			const AccessoryQueueEntry& entry = accessory.second.first;
 			AccessoryOff(entry.protocol, entry.address, entry.state);
 		}
 		logger->Info(Languages::TextTerminatingAccessorySenderThread);
@@ -493,7 +534,7 @@ namespace Hardware
 				continue;
 			}
 
-			logger->Hex(buffer, dataLength);
+			logger->Received(buffer, dataLength);
 
 			ssize_t dataRead = 0;
 			while (dataRead < dataLength)
@@ -1109,7 +1150,7 @@ namespace Hardware
 
 	int Z21::Send(const unsigned char* buffer, const size_t bufferLength)
 	{
-		logger->Hex(buffer, bufferLength);
+		logger->Sent(buffer, bufferLength);
 		return connection.Send(buffer, bufferLength);
 	}
 } // namespace
@@ -67,6 +67,11 @@ namespace Hardware
 			Z21(const HardwareParams* params);
 			~Z21();
 
+			inline Logger::Logger* GetLogger() const override
+			{
+				return logger;
+			}
+
 			inline Hardware::Capabilities GetCapabilities() const override
 			{
 				return Hardware::CapabilityLoco
@@ -114,6 +119,7 @@ namespace Hardware
 			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
 			{
 				argumentTypes[1] = ArgumentTypeIpAddress;
+				argumentTypes[2] = ArgumentTypeMaxEnergisedAccessories;
 				hint = Languages::GetText(Languages::TextHintZ21);
 			}
 
@@ -132,6 +138,15 @@ namespace Hardware
 				const Orientation orientation,
 				std::vector<DataModel::LocoFunctionEntry>& functions) override;
 
+			bool IsLocoStateCached(const Protocol protocol,
+				const Address address,
+				const Speed speed,
+				const Orientation orientation,
+				const std::vector<DataModel::LocoFunctionEntry>& functions) override
+			{
+				return locoCache.IsState(address, speed, orientation, protocol, functions);
+			}
+
 			void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration) override;
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
@@ -245,6 +260,8 @@ namespace Hardware
 			Z21TurnoutCache turnoutCache;
 			Z21FeedbackCache feedbackCache;
 			ProgramMode lastProgramMode;
+			// limits the current drawn by the coils of the accessories
+			const unsigned int maxEnergisedAccessories;
 			volatile bool connected;
 
 			Utils::ThreadSafeQueue<AccessoryQueueEntry> accessoryQueue;
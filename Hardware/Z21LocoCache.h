@@ -21,7 +21,9 @@ along with RailControl; see the file LICENCE. If not see
 #pragma once
 
 #include <map>
+#include <vector>
 
+#include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
 
 namespace Hardware
@@ -136,6 +138,31 @@ namespace Hardware
 				return cache[address].protocol;
 			}
 
+			bool IsState(const Address address,
+				const Speed speed,
+				const Orientation orientation,
+				const Protocol protocol,
+				const std::vector<DataModel::LocoFunctionEntry>& functions)
+			{
+				if (cache.count(address) == 0)
+				{
+					return false;
+				}
+				const Z21LocoCacheEntry& entry = cache[address];
+				if (entry.speed != speed || entry.orientation != orientation || entry.protocol != protocol)
+				{
+					return false;
+				}
+				for (const DataModel::LocoFunctionEntry& function : functions)
+				{
+					if (function.nr >= 32 || ((entry.functions >> function.nr) & 0x01) != (function.state == DataModel::LocoFunctionStateOn))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
 		private:
 			std::map<Address, Z21LocoCacheEntry> cache;
 	};
@@ -75,3 +75,45 @@ string ZLib::UnCompress(const char* input, const size_t inputSize, const size_t
 	free(outputBuffer);
 	return output;
 }
+
+string ZLib::CompressGzip(const string& input)
+{
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	// window bits 15 + 16 selects the gzip header instead of the zlib header
+	int ret = deflateInit2(&strm, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+	if (ret != Z_OK)
+	{
+		return "";
+	}
+
+	unsigned long outputSize = deflateBound(&strm, input.size());
+	unsigned char* outputBuffer = reinterpret_cast<unsigned char*>(malloc(outputSize));
+	if (outputBuffer == nullptr)
+	{
+		deflateEnd(&strm);
+		return "";
+	}
+	strm.avail_in = input.size();
+	strm.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(input.c_str()));
+	strm.avail_out = outputSize;
+	strm.next_out = outputBuffer;
+	ret = deflate(&strm, Z_FINISH);
+	deflateEnd(&strm);
+	if (ret != Z_STREAM_END)
+	{
+		free(outputBuffer);
+		return "";
+	}
+
+	string outputData(reinterpret_cast<char*>(outputBuffer), outputSize - strm.avail_out);
+	free(outputBuffer);
+	return outputData;
+}
+
+uint32_t ZLib::Crc32(const string& input)
+{
+	return crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const unsigned char*>(input.c_str()), input.size());
+}
@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 class ZLib
@@ -27,4 +28,7 @@ class ZLib
 	public:
 		static std::string Compress(const std::string& input);
 		static std::string UnCompress(const char* input, const size_t inputSize, const size_t outputSize);
+		// compresses input into the gzip format as used in HTTP Content-Encoding
+		static std::string CompressGzip(const std::string& input);
+		static uint32_t Crc32(const std::string& input);
 };
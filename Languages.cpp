@@ -72,6 +72,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextBridge */ { "Bridge", "Brücke", "Puente" },
 /* TextBufferStop */ { "End / Buffer Stop", "Ende / Prellbock", "Final / Tope" },
 /* TextCV */ { "CV", "CV", "CV" },
+/* TextCanNotOpenDirectory */ { "Can not open directory {0}", "Verzeichnis {0} kann nicht geöffnet werden", "No se puede abrir el directorio {0}" },
 /* TextCanNotOpenLibrary */ { "Can not open library {0}: {1}", "Kann Bibliothek {0} nicht öffenen: {1}", "Imposible abrir biblioteca {0}: {1}" },
 /* TextCanNotStartAlreadyRunning */ { "Can not start {0} because it is already running", "Unmöglich {0} zu starten weil schon gestartet", "Imposible poner {0} en marcha porque ya está en marcha" },
 /* TextCanNotStartInErrorState */ { "Can not start {0} because it is in error state", "Unmöglich {0} zu startein weil sie im Fehlerstatus ist", "Imposible poner {0} en marcha perque está en estado error" },
@@ -83,6 +84,10 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextClusterDoesNotExist */ { "Cluster does not exist", "Gruppe existiert nicht", "Grupo no existe" },
 /* TextClusterUpdated */ { "Cluster {0} updated", "Gruppe {0} aktualisiert", "Grupo {0} actualizado" },
 /* TextClusters */ { "Clusters", "Gruppen", "Grupos" },
+/* TextCommandStatistics */ { "{0} commands sent, {1} superseded commands dropped, {2} commands sent immediately", "{0} Befehle gesendet, {1} überholte Befehle verworfen, {2} Befehle sofort gesendet", "{0} comandos enviados, {1} comandos obsoletos descartados, {2} comandos enviados inmediatamente" },
+/* TextCommandsSent */ { "Commands sent", "Gesendete Befehle", "Comandos enviados" },
+/* TextCommandsSentImmediately */ { "Commands sent immediately", "Sofort gesendete Befehle", "Comandos enviados inmediatamente" },
+/* TextCommandsSuperseded */ { "Superseded commands dropped", "Verworfene überholte Befehle", "Comandos obsoletos descartados" },
 /* TextConfigFileReceivedWithSize */ { "Configuration file with {0} bytes received", "Konfigurationsdatei mit {0} Bytes empfangen", "Archivo de configuración recibido con {0} bytes" },
 /* TextConfigureControlFirst */ { "Please configure a control first", "Bitte zuerst eine Zentrale konfigurieren", "Por favor configura un control antes" },
 /* TextConnectionFailed */ { "Connection to {0}:{1} failed", "Verbindung zu {0}:{1} nicht möglich", "Imposible conectar a {0}:{1}" },
@@ -119,6 +124,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextDcc */ { "DCC", "DCC", "DCC" },
 /* TextDebounceThreadStarted */ { "Debounce thread started", "Entprellthread gestartet", "Antirebote thread encendido" },
 /* TextDebounceThreadTerminated */ { "Debounce thread terminated", "Entprellthread beedet", "Antirebote thread apagado" },
+/* TextDebounceTime */ { "Debounce time (ms)", "Entprellzeit (ms)", "Tiempo de antirebote (ms)" },
 /* TextDebouncer */ { "Debouncer", "Entpreller", "Antirebote" },
 /* TextDebug */ { "debug", "Entkäfern", "depurar" },
 /* TextDefaultSwitchingDuration */ { "Default switching duration (ms)", "Standard Schaltzeit (ms)", "Duración de conmutación por defecto (ms)" },
@@ -173,6 +179,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextFeedbackStateIsOn */ { "Feedback state of {0} is now on", "Der Status des Rückmelders {0} ist nun ein", "El estado de la retroseñal {0} está encendida" },
 /* TextFeedbackUpdated */ { "Feedback {0} updated", "Rückmelder {0} aktualisiert", "Retroseñal {0} actualizado" },
 /* TextFeedbacks */ { "Feedbacks", "Rückmelder", "Retroseñales" },
+/* TextFileName */ { "File name", "Dateiname", "Nombre de archivo" },
 /* TextFoundAccessoryInEcosDatabase */ { "Found accessory in ECoS database: Address: {0} Name: {1}/{2}/{3}", "Zubehörartikel in ECoS Datenbank gefunden: Adresse: {0} Name: {1}/{2}/{3}", "Encontrado un accessorio en la base de datos de ECoS: Dirección: {0} Nombre: {1}/{2}/{3}" },
 /* TextFoundFeedbackModuleInEcosDatabase */ { "Found feedback module in ECoS database: ID: {0}", "Rückmeldemodule in ECoS Datenbank gefunden: ID: {0}", "Encontrado un modulo retroseñal en la base de datos de ECoS: ID: {0}" },
 /* TextFoundLocoInEcosDatabase */ { "Found locomotive in ECoS database: Address: {0} Name: {1}", "Locomotive in ECoS Datenbank gefunden: Adresse: {0} Name: {1}", "Encontrado una locomotora en la base de datos de ECoS: Dirección: {0} Nombre: {1}" },
@@ -187,6 +194,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextHeightIs0 */ { "Height is zero", "Höhe ist null", "Altura está zero" },
 /* TextHint */ { "Hint:", "Hinweis:", "Nota:" },
 /* TextHintCcSchnitte */ { "Under Linux the virtual serial port is usually /dev/ttyUSB0.", "Unter Linux ist der erstellte virtuelle COM-Port üblicherweise /dev/ttyUSB0.", "Sobre Linux el puerto virtual normalmente es /dev/ttyUSB0." },
+/* TextHintCs2Replay */ { "Replays the frames received from a CS2/CS3 or CC-Schnitte that have been recorded with packetcapture = 1 in railcontrol.conf. Nothing is sent to any hardware.<br>Replay speed 1 uses the recorded timing, higher values replay faster.", "Spielt die von einer CS2/CS3 oder CC-Schnitte empfangenen Daten ab, die mit packetcapture = 1 in railcontrol.conf aufgezeichnet wurden. Es wird nichts an eine Hardware gesendet.<br>Wiedergabegeschwindigkeit 1 benutzt die aufgezeichneten Zeitabstände, höhere Werte spielen schneller ab.", "Reproduce los datos recibidos de una CS2/CS3 o CC-Schnitte que se han grabado con packetcapture = 1 en railcontrol.conf. No se envía nada a ningún hardware.<br>Velocidad de reproducción 1 utiliza los intervalos grabados, valores más altos reproducen más rápido." },
 /* TextHintCs2Tcp */ { "If you have an outdated CS2 software you must use CS2/CS3 UDP.", "Wenn die CS2 software veraltet ist muss stattdessen CS2/CS3 UDP verwendet werden.", "Si la software de la CS2 no está reciente, se tiene que usar CS2/CS3 UDP." },
 /* TextHintCs2Udp */ { "Try CS2/CS3 TCP (new protocol) first. Use the CS2/CS3 UDP only, if you have an outdated CS2 software version.<br>To connect to a Märklin Central Station 2 or 3, the firewall has to allow UDP-connections to the remote port 15731 and from the remote port 15730.<br>The CAN settings have to be &quot;broadcast&quot; and the IP of the RailControl server.", "Vorzugsweise wird das CS2/CS3 TCP Protokoll benutzt. CS2/CS3 UDP sollte nur verwendet werden, wenn die CS2 Software nicht mehr aktuell ist.<br>Um die Märklin Central Station 2 oder 3 mit RailControl zu verbinden, muss die Firewall UDP-Verbindungen zum Remote Port 15731, sowie UDP-Verbindungen zum lokalen Port 15730 zulassen.<br>Die CAN Einstellungen müssen auf &quot;broadcast&quot; und die IP auf die Adresse vom RailControl server gestellt werden.", "Está mejor utilzar CS2/CS3 TCP. Solamente use CS2/CS3 UDP si el software de CS2 no está reciente.<br>Para conectar a una Märklin Central Station 2 o 3, el cortafuegos tiene que permitir UDP-conexiones al puerto remoto 15731 y del puerto remote 15730.<br>Los ajustes CAN tienen que ser &quot;broadcast&quot; y la IP tiene que ser la direcctión del servidor RailControl." },
 /* TextHintEcos */ { "In the log you can see the IDs of the locomotives. Use these IDs as address.", "Im Log sind die IDs der Lokomotiven ersichtlich. Verwende diese als Adresse.", "En el log se puede ver los IDs de las locomotoras. Se tiene que usar estos IDs en el campo dirección." },
@@ -194,6 +202,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextHintM6051 */ { "Locomotives that are selected by a Central Control/Control 80/80f can not be controlled by RailControl.<br>The Interface 6050/6051 does not forward very short feedbacks. It is not recommended to use the feedbacks of the Interface 6050/6051 for automatic train control.", "Lokomotiven die von einer Central Control/Control 80/80f ausgewählt sind können von RailControl nicht gesteuert werden.<br>Das Interface 6050/6051 verschluckt sehr kurzzeitige Rückmelder. Ein Automatikbetrieb mit den Rückmeldern des Interface 6050/6051 ist deshalb nicht zu empfehlen.", "RailControl no puede controlar Locomotoras que estan selectionado por un Central Control/Control 80/80f.<br>El Interface 6050/6051 no puede procesar las retroseñales muy cortas. No es recomendada de utilisar las retroseñales del Interface 6050/6051 para modo automatico." },
 /* TextHintOpenDcc */ { "Under Linux the virtual serial port is usually /dev/ttyUSB0.<br>The OpenDcc does not forward very short feedbacks. It is not recommended to use the feedbacks of the OpenDCC for automatic train control.", "Unter Linux ist der erstellte virtuelle COM-Port üblicherweise /dev/ttyUSB0.<br>Das Interface 6050/6051 verschluckt sehr kurzzeitige Rückmelder. Ein Automatikbetrieb mit den Rückmeldern des Interface 6050/6051 ist deshalb nicht zu empfehlen.", "Sobre Linux el puerto virtual normalmente es /dev/ttyUSB0.<br>El OpenDCC no puede procesar las retroseñales muy cortas. No es recomendada de utilisar las retroseñales del OpenDCC para modo automatico." },
 /* TextHintRM485 */ { "This is a never published hardware of the main developer.", "Dies ist eine nie publizierte Hardware des Hauptentwicklers.", "Es un hardware que nunca fue publicado." },
+/* TextHintSimulation */ { "Simulates the movement of the locos in automode: a running loco reaches the next feedback of its reserved routes after the given time divided by its relative speed. Nothing is sent to any hardware.", "Simuliert die Fahrt der Loks im Automodus: Eine fahrende Lok erreicht den nächsten Rückmelder ihrer reservierten Fahrstrassen nach der angegebenen Zeit geteilt durch ihre relative Geschwindigkeit. Es wird nichts an eine Hardware gesendet.", "Simula el movimiento de las locomotoras en modo automático: una locomotora en marcha alcanza la siguiente retroseñal de sus itinerarios reservados después del tiempo indicado dividido por su velocidad relativa. No se envía nada a ningún hardware." },
 /* TextHintVirtual */ { "The virtual control does not have a physical representation. It is for testing only.", "Die virtuelle Zentrale hat keine physische Repräsentation. Sie ist ausschliesslich für Tests.", "El control virtual no tiene representation physica. Es solamente para tests." },
 /* TextHintZ21 */ { "To connect to a Z21, the firewall has to allow UDP-connections from and to the remote port 21105.", "Um die Z21 mit RailControl zu verbinden, muss die Firewall UDP-Verbindungen von und zum remote Port 21105 zulassen.", "Para conectar a un Z21, el cortafuegos tiene que permitir UDP-conexiones del y al puerto remoto 21105." },
 /* TextHitOverrun */ { "{0} hit overrun feedback {1}", "{0} erreichte Überfahr-Rückmelder {1}", "{0} ha pasado a {1}" },
@@ -203,18 +212,21 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextHttpConnectionNotFound */ { "HTTP connection {0}: 404 Not found: {1}", "HTTP Verbindung {0}: Nicht gefunden: {1}", "HTTP connectión {0}: no encontrado" },
 /* TextHttpConnectionNotImplemented */ { "HTTP connection {0}: HTTP method {1} not implemented", "HTTP Verbindung {0}: Methode {1} nicht implementiert", "HTTP connectión {0}: no implementado" },
 /* TextHttpConnectionOpen */ { "HTTP connection {0}: open", "HTTP Verbindung {0}: geöffnet", "HTTP connectión {0}: abierto" },
+/* TextHttpConnectionRejected */ { "HTTP connection {0}: rejected, maximum of {1} clients reached", "HTTP Verbindung {0}: abgelehnt, Maximum von {1} Clients erreicht", "HTTP connectión {0}: rechazado, máximo de {1} clientes alcanzado" },
 /* TextHttpConnectionRequest */ { "HTTP connection {0}: Request: {1} {2}", "HTTP Verbindung {0}: Anfrage {1} {2}", "HTTP connectión {0}: solicitud: {1} {2}" },
+/* TextHttpConnectionsActive */ { "Active HTTP connections", "Aktive HTTP Verbindungen", "Conexiones HTTP activas" },
+/* TextHttpConnectionsRejected */ { "Rejected HTTP connections", "Abgelehnte HTTP Verbindungen", "Conexiones HTTP rechazadas" },
+/* TextHttpConnectionsTotal */ { "Total HTTP connections", "HTTP Verbindungen insgesamt", "Conexiones HTTP en total" },
 /* TextIPAddress */ { "IP address", "IP Adresse", "Dirección IP" },
 /* TextIndex */ { "Index", "Index", "Index" },
 /* TextInfo */ { "info", "Informationen", "informaciones" },
 /* TextInvalidControlID */ { "Invalid controlID {0}", "Ungültige Control ID {0}", "Control ID {0} no valido" },
 /* TextInvalidDataReceived */ { "Invalid data received", "Ungültige Daten empfangen", "Recibido datos no validos" },
+/* TextInvalidPacketCapture */ { "{0} is not a valid packet capture", "{0} ist keine gültige Paketaufzeichnung", "{0} no es una grabación de paquetes válida" },
 /* TextInverted */ { "Inverted", "Invertiert", "Invertido" },
 /* TextIsInAutomodeWithoutRouteTrack */ { "{0} is in automode without a route or track set. Setting error state.", "{0} ist im Automodus ohne Fahrstrasse oder Gleis. Setze Fehlerstatus.", "{0} está en modo auto sin itinerario o vía. Poniando estado error." },
 /* TextIsInErrorState */ { "{0} is in error state", "{0} ist im Fehlerstatus", "{0} está en estado error" },
 /* TextIsInInvalidAutomodeState */ { "{0} is running in invalid automode state {1} while {2} is reached. Setting error state.", "{0} ist in unerlaubten Automode Status {1} während {2} erreicht wurde. Setze Fehlerstatus.", "{0} está en estado ilegal {1} mientras llegando {2}. Poniando estado error." },
-/* TextIsInManualState */ { "{0} is in manual state while automode is running. Setting error state.", "{0} ist im Status manuell während der Auto-Modus eingeschaltet ist. Setze Fehlerstatus.", "{0} está en estado manual durante modo auto. Poniando estado error." },
-/* TextIsInTerminatedState */ { "{0} is in terminated state while automode is running. Setting error state.", "{0} ist im Status beendet während der Auto-Modus eingeschaltet ist. Setze Fehlerstatus.", "{0} está en estado terminado durante modo auto. Poniando estado error." },
 /* TextIsLocked */ { "{0} is locked", "{0} ist gesperrt", "{0} está bloqueado" },
 /* TextIsNotFree */ { "{0} is not free", "{0} ist nicht frei", "{0} no está libre" },
 /* TextIsNotOnTrack */ { "{0} is not on a track. Switching to manual mode.", "{0} ist nicht auf einem Gleis. Wechsle in den Modus manuell.", "{0} no está sobre una vía. Poniando en modo manual." },
@@ -374,13 +386,18 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLocoIsReleased */ { "{0} is released", " {0} ist freigegeben", "{0} está desbloqueada" },
 /* TextLocoSaved */ { "Locomotive {0} saved", "Lokomotive {0} gespeichert", "Locomotora {0} guardado" },
 /* TextLocoSpeedIs */ { "Speed of {0} is now {1}", "Die Geschwindigkeit von {0} ist {1}", "La velocidad de {0} está {1}" },
+/* TextLocoStatesSent */ { "State of {0} of {1} locos sent to the controls", "Zustand von {0} von {1} Loks an die Steuerungen gesendet", "Estado de {0} de {1} locomotoras enviado a los controles" },
 /* TextLocoUpdated */ { "Locomotive {0} updated", "Lokomotive {0} aktualisiert", "Locomotora {0} actualizado" },
 /* TextLocos */ { "Locomotives", "Lokomotiven", "Locomotoras" },
 /* TextLogLevel */ { "Log level", "Log Level", "Nivel de registro" },
+/* TextLogMessagesDropped */ { "{0} log messages dropped because the log queue was full", "{0} Log-Meldungen verworfen, weil die Warteschlange voll war", "{0} mensajes de registro descartados porque la cola estaba llena" },
+/* TextLogMessagesDroppedTotal */ { "Dropped log messages", "Verworfene Log-Meldungen", "Mensajes de registro descartados" },
+/* TextLogMessagesWritten */ { "Written log messages", "Geschriebene Log-Meldungen", "Mensajes de registro escritos" },
 /* TextLongestUnused */ { "Longest unused", "Am längsten ungenutzt", "El más largo sin usar" },
 /* TextLookingForDestination */ {"Looking for new destination starting from {0}", "Suche von {0} aus neues Ziel", "Buscando nuevo destino deste {0}" },
 /* TextMaerklinMotorola */ { "Märklin Motorola", "Märklin Motorola", "Märklin Motorola" },
 /* TextManager */ { "Manager", "Manager", "Manager" },
+/* TextMaxEnergisedAccessories */ { "Max. simultaneously switched accessories", "Max. gleichzeitig geschaltete Zubehörartikel", "Máx. accesorios conmutados simultáneamente" },
 /* TextMaxSpeed */ { "Maximum speed", "Maximale Geschwindigkeit", "Velocidad máxima" },
 /* TextMaxTrainLength */ { "Maximal train length", "Maximale Zuglänge", "Longitud de tren maxima" },
 /* TextMembers */ { "Members", "Teilnehmer", "Miembros" },
@@ -422,8 +439,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextProgramDccPomLocoWrite */ { "Programming DCC CV {1} to value {2} of locomotive with address {0} on main", "Programmiere DCC CV {1} auf Wert {2} der Lokomotive mit Adresse {0} auf dem Hauptgleis", "Escribiendo DCC CV {1} al valor {2} de la locomotora con dirección {0} en vía principal" },
 /* TextProgramDccRead */ { "Reading DCC CV {0} on programming track", "Lese DCC CV {0} auf dem Programmiergleis", "Leyendo DCC CV {0} en la vía de programación" },
 /* TextProgramDccWrite */ { "Programming DCC CV {0} to value {1} on programming track", "Programmiere DCC CV {0} auf Wert {1} auf dem Programmiergleis", "Programando DCC CV {0} al valor {1}" },
-/* TextProgramMfxRead */ { "Reading mfx CV {1} of locomotive with address {0}", "Lese mfx CV {1} der Lokomotive mit Adresse {0}", "Leyendo mfx CV {0} de la locomotora con dirección {0}" },
-/* TextProgramMfxWrite */ { "Writing mfx CV {1} to value {2} of locomotive with address {0}", "Schreibe mfx CV {1} auf Wert {2} der Lokomotive mit Adresse {0}", "Escribiendo mfx CV {0} al valor {2} de la locomotora con dirección {0}" },
+/* TextProgramMfxRead */ { "Reading mfx CV {1} of locomotive with address {0}", "Lese mfx CV {1} der Lokomotive mit Adresse {0}", "Leyendo mfx CV {1} de la locomotora con dirección {0}" },
+/* TextProgramMfxWrite */ { "Writing mfx CV {1} to value {2} of locomotive with address {0}", "Schreibe mfx CV {1} auf Wert {2} der Lokomotive mit Adresse {0}", "Escribiendo mfx CV {1} al valor {2} de la locomotora con dirección {0}" },
 /* TextProgramMm */ { "Programming Märklin Motorola variable {0} to value {1} on programming track", "Programmiere Märklin Motorola Variable {0} auf Wert {1} auf dem Programmiergleis", "Programando Märklin Motorol variable {0} al valor {1} en la vía de programación" },
 /* TextProgramMmPom */ { "Programming Märklin Motorola variable {1} to value {2} of locomotive with address {0} on main", "Programmiere Märklin Motorola Variable {1} auf Wert {2} der Lokomotive mit Adresse {0} auf dem Hauptgleis", "Programando Märklin Motorol variable {1} al valor {2} de la locomotora con dirección {0} en vía principal" },
 /* TextProgramMode */ { "Mode", "Modus", "Modo" },
@@ -450,7 +467,6 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextReceivedAccessoryCommand */ { "Received command for accessory {0}/{1}: {2}", "Zubehörartikelkommando empfangen {0}/{1}: {2}", "Recibido comando para accesorio {0}/{1}: {2}" },
 /* TextReceivedDirectionCommand */ { "Received direction command for locomotive {0}/{1}: {2}", "Richtungskommando empfangen für Lokomotive {0}/{1}: {2}", "Recibido comando de direccion para locomotora {0}/{1}: {2}" },
 /* TextReceivedFunctionCommand */ { "Received function command for locomotive {0}/{1} and function {2}: {3}", "Funktionskommando empfangen für Lokomotive {0}/{1} und Funktion {2}: {3}", "Recibido comando de funcciona para locomotora {0}/{1} y funcciona {2}: {3}" },
-/* TextReceivedSignalKill */ { "Received a signal kill {0} times. Exiting without saving.", "Signal Kill {0} mal erhalten. Beende RailControl ohne zu speichern.", "Señal Kill recibido {0} veces. Apagando RailControl sin guardar." },
 /* TextReceivedSpeedCommand */ { "Received speed command for locomotive {0}/{1}: {2}", "Geschwindigkeitskommando empfangen für Lokomotive {0}/{1}: {2}", "Recibido comando de velocidad para locomotora {0}/{1}: {2}" },
 /* TextReceiverThreadStarted */ { "Receiver thread started", "Empfangs-Thread gestartet", "Thread recibiendo creado" },
 /* TextRed */ { "red", "rot", "rojo" },
@@ -469,6 +485,10 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextReleaseWhenFree */ { "Release when free", "Freigeben wenn nicht besetzt", "Liberar si no está ocupado" },
 /* TextRemoveBackupFile */ { "Removing backup file {0}", "Lösche Sicherungskopie {0}", "Eliminando copia de respaldo {0}" },
 /* TextRenamingFromTo */ { "Renaming from {0} to {1}", "Benenne von {0} nach {1} um", "Renombrando de {0} a {1}" },
+/* TextReplayFinished */ { "Replayed {0} frames in {1} ms", "{0} Pakete in {1} ms abgespielt", "{0} paquetes reproducidos en {1} ms" },
+/* TextReplayReactionTime */ { "Reaction time from feedback to loco command: {0} times, average {1} µs, maximum {2} µs", "Reaktionszeit von Rückmelder zu Lokbefehl: {0} mal, durchschnittlich {1} µs, maximal {2} µs", "Tiempo de reacción de retroseñal a comando de locomotora: {0} veces, promedio {1} µs, máximo {2} µs" },
+/* TextReplaySpeed */ { "Replay speed (0 = as fast as possible)", "Wiedergabegeschwindigkeit (0 = so schnell wie möglich)", "Velocidad de reproducción (0 = lo más rápido posible)" },
+/* TextReplayStarted */ { "Replaying {0}", "Spiele {0} ab", "Reproduciendo {0}" },
 /* TextRestarting */ { "Restarting", "Neustart", "Reiniciando" },
 /* TextRight */ { "right", "rechts", "derecha" },
 /* TextRotation */ { "Rotation", "Drehung", "Rotación", },
@@ -484,6 +504,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextRoutes */ { "Routes", "Fahrstrassen", "Itinerarios" },
 /* TextSQLiteErrorQuery */ { "SQLite error: {0} Query: {1}", "SQLite Fehler: {0} Query: {1}", "Error de SQLite: {0} Query: {1}" },
 /* TextSaving */ { "Saving {0}", "Speichere {0}", "Guardando {0}" },
+/* TextSectionTime */ { "Time between two feedbacks at maximum speed (ms)", "Zeit zwischen zwei Rückmeldern bei Maximalgeschwindigkeit (ms)", "Tiempo entre dos retroseñales a velocidad máxima (ms)" },
 /* TextSelectLocoForTrack */ {"Select locomotive for track {0}", "Wähle Lokomotive für Gleis {0}", "Selectione locomotora para vía {0}" },
 /* TextSelectRouteBy */ { "Select route by", "Wähle die Fahrstrasse nach", "Selecctionar itinerario por" },
 /* TextSenderSocketCreated */ {"Sender socket created", "Sender socket erstellt", "Socket para enviar datos creado" },
@@ -522,6 +543,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextSignals */ { "Signals", "Signale", "Señales" },
 /* TextSimpleLeft */ { "simple left", "einfach links", "simple izquierda" },
 /* TextSimpleRight */ { "simple right", "einfach rechts", "simple derecha" },
+/* TextSimulationStatistics */ { "{0} of {1} locos running, {2} feedbacks reached, reaction time average {3} µs, maximum {4} µs", "{0} von {1} Loks fahren, {2} Rückmelder erreicht, Reaktionszeit durchschnittlich {3} µs, maximal {4} µs", "{0} de {1} locomotoras en marcha, {2} retroseñales alcanzadas, tiempo de reacción promedio {3} µs, máximo {4} µs" },
 /* TextSpanish */ { "Spanisch", "Spanisch", "Español" },
 /* TextSpeed */ { "Speed", "Geschwindigkeit", "Velocidad" },
 /* TextStartLoco */ { "Start locomotive", "Starte Lokomotive", "Poner locomotora en marcha" },
@@ -619,6 +641,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextUnblockTrack */ { "Unblock track", "Deblockere Gleis", "Desbloquear vía" },
 /* TextUnknownObjectType */ { "Unknown object type", "Unbekannter Objekttyp", "Typo de objecto desconocido" },
 /* TextUnloadingControl */ { "Unloading control {0}: {1}", "Entlade Zentrale {0}: {1}", "Descargando control {0}: {1}" },
+/* TextUpdatesLost */ { "{0} updates lost, reloading layout", "{0} Aktualisierungen verloren, Gleisbild wird neu geladen", "{0} actualizaciones perdidas, recargando el plano" },
 /* TextValue */ { "Value", "Wert", "Valor" },
 /* TextVersion */ { "Version: {0}", "Version: {0}", "Versión: {0}" },
 /* TextVisible */ { "Visible", "Sichtbar", "Visible" },
@@ -626,6 +649,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextWaitingTimeBetweenMembers */ { "Waiting time between members (ms)", "Wartezeit zwischen Teilnehmern (ms)", "Tiempo de esprera entre los miembros (ms)" },
 /* TextWaitingUntilHasStopped */ { "Waiting until {0} has stopped", "Warte bis {0} angehalten hat", "Esperando hasta {0} ha parado" },
 /* TextWarning */ { "warning", "Warnungen", "advertencias" },
+/* TextWebServerFilesCached */ { "{0} files of directory {1} cached", "{0} Dateien aus Verzeichnis {1} zwischengespeichert", "{0} archivos del directorio {1} almacenados en caché" },
 /* TextWebServerStarted */ { "Webserver started", "Webserver wurde gestartet", "Servidor web encendido" },
 /* TextWebServerStopped */ { "Webserver stopped", "Webserver wurde beendet", "Servidor web apagado" },
 /* TextWidthIs0 */ { "Width is zero", "Breite ist null", "Anchura está zero" },
@@ -72,6 +72,7 @@ class Languages
 			TextBridge,
 			TextBufferStop,
 			TextCV,
+			TextCanNotOpenDirectory,
 			TextCanNotOpenLibrary,
 			TextCanNotStartAlreadyRunning,
 			TextCanNotStartInErrorState,
@@ -83,6 +84,10 @@ class Languages
 			TextClusterDoesNotExist,
 			TextClusterUpdated,
 			TextClusters,
+			TextCommandStatistics,
+			TextCommandsSent,
+			TextCommandsSentImmediately,
+			TextCommandsSuperseded,
 			TextConfigFileReceivedWithSize,
 			TextConfigureControlFirst,
 			TextConnectionFailed,
@@ -119,6 +124,7 @@ class Languages
 			TextDcc,
 			TextDebounceThreadStarted,
 			TextDebounceThreadTerminated,
+			TextDebounceTime,
 			TextDebouncer,
 			TextDebug,
 			TextDefaultSwitchingDuration,
@@ -173,6 +179,7 @@ class Languages
 			TextFeedbackStateIsOn,
 			TextFeedbackUpdated,
 			TextFeedbacks,
+			TextFileName,
 			TextFoundAccessoryInEcosDatabase,
 			TextFoundFeedbackModuleInEcosDatabase,
 			TextFoundLocoInEcosDatabase,
@@ -187,6 +194,7 @@ class Languages
 			TextHeightIs0,
 			TextHint,
 			TextHintCcSchnitte,
+			TextHintCs2Replay,
 			TextHintCs2Tcp,
 			TextHintCs2Udp,
 			TextHintEcos,
@@ -194,6 +202,7 @@ class Languages
 			TextHintM6051,
 			TextHintOpenDcc,
 			TextHintRM485,
+			TextHintSimulation,
 			TextHintVirtual,
 			TextHintZ21,
 			TextHitOverrun,
@@ -203,18 +212,21 @@ class Languages
 			TextHttpConnectionNotFound,
 			TextHttpConnectionNotImplemented,
 			TextHttpConnectionOpen,
+			TextHttpConnectionRejected,
 			TextHttpConnectionRequest,
+			TextHttpConnectionsActive,
+			TextHttpConnectionsRejected,
+			TextHttpConnectionsTotal,
 			TextIPAddress,
 			TextIndex,
 			TextInfo,
 			TextInvalidControlID,
 			TextInvalidDataReceived,
+			TextInvalidPacketCapture,
 			TextInverted,
 			TextIsInAutomodeWithoutRouteTrack,
 			TextIsInErrorState,
 			TextIsInInvalidAutomodeState,
-			TextIsInManualState,
-			TextIsInTerminatedState,
 			TextIsLockedBy,
 			TextIsNotFree,
 			TextIsNotOnTrack,
@@ -374,13 +386,18 @@ class Languages
 			TextLocoIsReleased,
 			TextLocoSaved,
 			TextLocoSpeedIs,
+			TextLocoStatesSent,
 			TextLocoUpdated,
 			TextLocos,
 			TextLogLevel,
+			TextLogMessagesDropped,
+			TextLogMessagesDroppedTotal,
+			TextLogMessagesWritten,
 			TextLongestUnused,
 			TextLookingForDestination,
 			TextMaerklinMotorola,
 			TextManager,
+			TextMaxEnergisedAccessories,
 			TextMaxSpeed,
 			TextMaxTrainLength,
 			TextMembers,
@@ -450,7 +467,6 @@ class Languages
 			TextReceivedAccessoryCommand,
 			TextReceivedDirectionCommand,
 			TextReceivedFunctionCommand,
-			TextReceivedSignalKill,
 			TextReceivedSpeedCommand,
 			TextReceiverThreadStarted,
 			TextRed,
@@ -469,6 +485,10 @@ class Languages
 			TextReleaseWhenFree,
 			TextRemoveBackupFile,
 			TextRenamingFromTo,
+			TextReplayFinished,
+			TextReplayReactionTime,
+			TextReplaySpeed,
+			TextReplayStarted,
 			TextRestarting,
 			TextRight,
 			TextRotation,
@@ -484,6 +504,7 @@ class Languages
 			TextRoutes,
 			TextSQLiteErrorQuery,
 			TextSaving,
+			TextSectionTime,
 			TextSelectLocoForTrack,
 			TextSelectRouteBy,
 			TextSenderSocketCreated,
@@ -522,6 +543,7 @@ class Languages
 			TextSignals,
 			TextSimpleLeft,
 			TextSimpleRight,
+			TextSimulationStatistics,
 			TextSpanish,
 			TextSpeed,
 			TextStartLoco,
@@ -619,6 +641,7 @@ class Languages
 			TextUnblockTrack,
 			TextUnknownObjectType,
 			TextUnloadingControl,
+			TextUpdatesLost,
 			TextValue,
 			TextVersion,
 			TextVisible,
@@ -626,6 +649,7 @@ class Languages
 			TextWaitingTimeBetweenMembers,
 			TextWaitingUntilHasStopped,
 			TextWarning,
+			TextWebServerFilesCached,
 			TextWebServerStarted,
 			TextWebServerStopped,
 			TextWidthIs0,
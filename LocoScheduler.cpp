@@ -0,0 +1,160 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "DataModel/Loco.h"
+#include "Languages.h"
+#include "LocoScheduler.h"
+#include "Utils/Utils.h"
+
+using DataModel::Loco;
+
+const LocoScheduler::Delay LocoScheduler::WaitForEvent = LocoScheduler::Delay::max();
+
+LocoScheduler::LocoScheduler(const unsigned int nrOfWorkers, const unsigned int retryInterval)
+:	retryInterval(retryInterval),
+	run(true)
+{
+	for (unsigned int worker = 0; worker < (nrOfWorkers > 0 ? nrOfWorkers : 1); ++worker)
+	{
+		workers.push_back(std::thread(&LocoScheduler::Worker, this));
+	}
+}
+
+LocoScheduler::~LocoScheduler()
+{
+	Terminate();
+}
+
+void LocoScheduler::Schedule(Loco* loco, const Deadline deadline)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	ScheduleUnlocked(loco, deadline);
+}
+
+void LocoScheduler::ScheduleUnlocked(Loco* loco, const Deadline deadline)
+{
+	auto scheduled = deadlines.find(loco);
+	if (scheduled != deadlines.end())
+	{
+		if (scheduled->second <= deadline)
+		{
+			return;
+		}
+		queue.erase(std::make_pair(scheduled->second, loco));
+		scheduled->second = deadline;
+	}
+	else
+	{
+		deadlines[loco] = deadline;
+	}
+	queue.emplace(deadline, loco);
+	queueCondition.notify_one();
+}
+
+void LocoScheduler::WakeWaiting()
+{
+	const Deadline now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(mutex);
+	if (queue.empty() || queue.rbegin()->first <= now)
+	{
+		return;
+	}
+	queue.clear();
+	for (auto& scheduled : deadlines)
+	{
+		if (scheduled.second > now)
+		{
+			scheduled.second = now;
+		}
+		queue.emplace(scheduled.second, scheduled.first);
+	}
+	queueCondition.notify_all();
+}
+
+void LocoScheduler::Remove(Loco* loco)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	auto scheduled = deadlines.find(loco);
+	if (scheduled != deadlines.end())
+	{
+		queue.erase(std::make_pair(scheduled->second, loco));
+		deadlines.erase(scheduled);
+	}
+	while (running.count(loco) != 0)
+	{
+		runningCondition.wait(lock);
+	}
+}
+
+void LocoScheduler::Terminate()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+	}
+	queueCondition.notify_all();
+	for (auto& worker : workers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+}
+
+void LocoScheduler::Worker()
+{
+	Utils::Utils::SetMinThreadPriority();
+	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextAutomode));
+	std::unique_lock<std::mutex> lock(mutex);
+	while (run)
+	{
+		// a loco that is stepped by another worker has to wait until that step has finished
+		auto entry = queue.begin();
+		while (entry != queue.end() && running.count(entry->second) != 0)
+		{
+			++entry;
+		}
+		if (entry == queue.end())
+		{
+			queueCondition.wait(lock);
+			continue;
+		}
+		if (entry->first > std::chrono::steady_clock::now())
+		{
+			queueCondition.wait_until(lock, entry->first);
+			continue;
+		}
+
+		Loco* loco = entry->second;
+		deadlines.erase(loco);
+		queue.erase(entry);
+		running.insert(loco);
+		lock.unlock();
+		const Delay delay = loco->AutoModeStep();
+		lock.lock();
+		running.erase(loco);
+		runningCondition.notify_all();
+		if (delay != WaitForEvent)
+		{
+			ScheduleUnlocked(loco, std::chrono::steady_clock::now() + delay);
+		}
+	}
+}
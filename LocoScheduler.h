@@ -0,0 +1,91 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace DataModel
+{
+	class Loco;
+}
+
+// runs the automode state machines of all locos on a fixed number of worker threads
+// a loco is only stepped when an event woke it or when its timeout elapsed,
+// the steps of one loco never run concurrently
+class LocoScheduler
+{
+	public:
+		typedef std::chrono::steady_clock::time_point Deadline;
+		typedef std::chrono::milliseconds Delay;
+
+		// returned by a step that only has to run again on an event
+		static const Delay WaitForEvent;
+
+		LocoScheduler() = delete;
+		LocoScheduler(const LocoScheduler&) = delete;
+		LocoScheduler& operator=(const LocoScheduler&) = delete;
+
+		// retryInterval is the time in milliseconds between two searches for a free route
+		LocoScheduler(const unsigned int nrOfWorkers, const unsigned int retryInterval);
+		~LocoScheduler();
+
+		// steps the loco as soon as a worker is free
+		inline void Wake(DataModel::Loco* loco)
+		{
+			Schedule(loco, std::chrono::steady_clock::now());
+		}
+
+		// steps the loco at deadline unless it is woken earlier
+		void Schedule(DataModel::Loco* loco, const Deadline deadline);
+
+		// steps all locos waiting for a timeout, e.g. because a track or route has been released
+		void WakeWaiting();
+
+		// forgets the loco and waits until its running step has finished
+		void Remove(DataModel::Loco* loco);
+
+		void Terminate();
+
+		inline Delay GetRetryInterval() const
+		{
+			return retryInterval;
+		}
+
+	private:
+		void Worker();
+		void ScheduleUnlocked(DataModel::Loco* loco, const Deadline deadline);
+
+		const Delay retryInterval;
+		std::set<std::pair<Deadline,DataModel::Loco*>> queue;
+		std::map<DataModel::Loco*,Deadline> deadlines;
+		std::set<DataModel::Loco*> running;
+		std::mutex mutex;
+		std::condition_variable queueCondition;
+		std::condition_variable runningCondition;
+		volatile bool run;
+		std::vector<std::thread> workers;
+};
@@ -18,8 +18,6 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <iomanip>
-#include <sstream>
 #include <sys/time.h> // gettimeofday
 
 #include "Logger/Logger.h"
@@ -42,80 +40,188 @@ namespace Logger
 		return string(buffer);
 	}
 
-	void Logger::Replace(string& workString,
-		const unsigned char argument,
-		const std::string& value)
+	size_t Logger::Placeholder(const char* input, unsigned char& argument)
 	{
-		std::string needle = "{" + std::to_string(argument) + "}";
-		size_t pos = workString.find(needle);
-		if (pos == std::string::npos)
+		if (input[0] != '{')
 		{
-			return;
+			return 0;
 		}
-		workString.replace(pos, needle.size(), value);
+		unsigned int value = 0;
+		size_t pos = 1;
+		while (input[pos] >= '0' && input[pos] <= '9' && pos <= 3)
+		{
+			value = value * 10 + (input[pos] - '0');
+			++pos;
+		}
+		if (pos == 1 || input[pos] != '}' || value >= NoArgument)
+		{
+			return 0;
+		}
+		argument = static_cast<unsigned char>(value);
+		return pos + 1;
 	}
 
-	void Logger::AsciiPart(std::stringstream& output, const unsigned char* input, const size_t size)
+	std::vector<Logger::Segment> Logger::Parse(const char* input)
 	{
-		output << "  ";
-		if (size < 8)
+		std::vector<Segment> segments;
+		const char* literal = input;
+		const char* pos = input;
+		while (*pos != 0)
 		{
-			output << "  ";
+			unsigned char argument;
+			const size_t length = Placeholder(pos, argument);
+			if (length == 0)
+			{
+				++pos;
+				continue;
+			}
+			if (pos > literal)
+			{
+				segments.push_back({ literal, static_cast<size_t>(pos - literal), NoArgument });
+			}
+			segments.push_back({ pos, length, argument });
+			pos += length;
+			literal = pos;
 		}
-		for (size_t index = size; index < 16; ++index)
+		if (pos > literal)
 		{
-			output << "   ";
+			segments.push_back({ literal, static_cast<size_t>(pos - literal), NoArgument });
 		}
-		for (size_t index = 0; index < size; ++index)
+		return segments;
+	}
+
+	std::vector<std::vector<Logger::Segment>> Logger::ParseAllTexts()
+	{
+		std::vector<std::vector<Segment>> templates;
+		templates.reserve(Languages::MaxLanguages * Languages::MaxTexts);
+		for (unsigned int language = 0; language < Languages::MaxLanguages; ++language)
 		{
-			if (index == 8)
+			for (unsigned int text = 0; text < Languages::MaxTexts; ++text)
 			{
-				output << " ";
+				templates.push_back(Parse(Languages::GetText(static_cast<Languages::Language>(language), static_cast<Languages::TextSelector>(text))));
 			}
-			if (input[index] >= 0x20 && input[index] < 127)
+		}
+		return templates;
+	}
+
+	const std::vector<Logger::Segment>& Logger::Template(const Languages::TextSelector text)
+	{
+		// the texts of all languages are parsed when the first text is used
+		static const std::vector<std::vector<Segment>> templates = ParseAllTexts();
+		static const std::vector<Segment> unknownText;
+		const Languages::Language language = Languages::GetDefaultLanguage();
+		if (language >= Languages::MaxLanguages || text >= Languages::MaxTexts)
+		{
+			return unknownText;
+		}
+		return templates[language * Languages::MaxTexts + text];
+	}
+
+	void Logger::Append(string& output, const char* input, const string* arguments, const size_t count)
+	{
+		const char* literal = input;
+		const char* pos = input;
+		while (*pos != 0)
+		{
+			unsigned char argument;
+			const size_t length = Placeholder(pos, argument);
+			if (length == 0 || argument >= count)
 			{
-				output << input[index];
+				pos += length > 0 ? length : 1;
+				continue;
 			}
-			else
+			output.append(literal, pos - literal);
+			output.append(arguments[argument]);
+			pos += length;
+			literal = pos;
+		}
+		output.append(literal, pos - literal);
+	}
+
+	void Logger::Append(string& output, const std::vector<Segment>& segments, const string* arguments, const size_t count)
+	{
+		for (auto& segment : segments)
+		{
+			if (segment.argument < count)
 			{
-				output << ".";
+				output.append(arguments[segment.argument]);
+				continue;
 			}
+			// literal text and placeholders without argument are copied unchanged
+			output.append(segment.text, segment.length);
 		}
 	}
 
-	void Logger::Hex(const unsigned char* input, const size_t size)
+	void Logger::Log(const char* type, const std::vector<Segment>& segments, const string* arguments, const size_t count)
+	{
+		string line = DateTime();
+		line.append(": ").append(type).append(": ").append(component).append(": ");
+		Append(line, segments, arguments, count);
+		line.append("\n");
+		server.Send(std::move(line));
+	}
+
+	void Logger::Log(const char* type, const char* text, const string* arguments, const size_t count)
+	{
+		string line = DateTime();
+		line.append(": ").append(type).append(": ").append(component).append(": ");
+		Append(line, text, arguments, count);
+		line.append("\n");
+		server.Send(std::move(line));
+	}
+
+	void Logger::HexDump(const unsigned char* input, const size_t size)
 	{
-		std::stringstream output;
-		size_t index;
-		for (index = 0; index < size; ++index)
+		static const char digits[] = "0123456789abcdef";
+		// every line holds 16 bytes: offset, hex values and printable characters
+		string line;
+		line.reserve(96);
+		size_t index = 0;
+		do
 		{
-			if ((index & 0x0F) == 0)
+			line.clear();
+			const size_t count = size - index < 16 ? size - index : 16;
+			if (count > 0)
 			{
-				output << "0x" << std::setfill('0') << std::setw(4) << std::hex << index << "   ";
+				line.append("0x");
+				unsigned int offsetDigits = 4;
+				while (offsetDigits < 2 * sizeof(size_t) && (index >> (4 * offsetDigits)) != 0)
+				{
+					++offsetDigits;
+				}
+				while (offsetDigits > 0)
+				{
+					--offsetDigits;
+					line.push_back(digits[(index >> (4 * offsetDigits)) & 0x0F]);
+				}
+				line.append("   ");
 			}
 
-			output << std::setfill('0') << std::setw(2) << std::hex << static_cast<unsigned int>(input[index]) << " ";
-
-			size_t next = index + 1;
-			if ((next & 0x0F) == 0)
+			const unsigned char* data = input + index;
+			for (size_t byte = 0; byte < count; ++byte)
 			{
-				AsciiPart(output, input + index - 15, 16);
-				Debug(output.str());
-				output.str(std::string());
-				if (next == size)
+				line.push_back(digits[data[byte] >> 4]);
+				line.push_back(digits[data[byte] & 0x0F]);
+				line.push_back(' ');
+				if (byte == 7)
 				{
-					return;
+					line.append("  ");
 				}
-				continue;
 			}
-			if ((next & 0x07) == 0)
+
+			line.append(count < 8 ? "    " : "  ");
+			line.append(3 * (16 - count), ' ');
+			for (size_t byte = 0; byte < count; ++byte)
 			{
-				output << "  ";
+				if (byte == 8)
+				{
+					line.push_back(' ');
+				}
+				line.push_back(data[byte] >= 0x20 && data[byte] < 127 ? static_cast<char>(data[byte]) : '.');
 			}
-		}
-		size_t reminder = (index & 0x0F);
-		AsciiPart(output, input + index - reminder, reminder);
-		Debug(output.str());
+
+			Log("Debug", line.c_str(), nullptr, 0);
+			index += count;
+		} while (index < size);
 	}
 }
-
@@ -20,10 +20,13 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "Languages.h"
 #include "Logger/LoggerServer.h"
+#include "Logger/PacketCapture.h"
 #include "Network/TcpServer.h"
 
 namespace Logger
@@ -42,10 +45,17 @@ namespace Logger
 
 			Logger(LoggerServer& server, const std::string& component)
 			:	server(server),
-			 	component(component)
+			 	component(component),
+			 	capture(nullptr)
 			{}
 
-			~Logger() {};
+			~Logger()
+			{
+				delete capture;
+			}
+
+			Logger(const Logger&) = delete;
+			Logger& operator=(const Logger&) = delete;
 
 			static Logger* GetLogger(const std::string& component)
 			{
@@ -78,12 +88,11 @@ namespace Logger
 				return std::string(input);
 			}
 
+			// every {n} in input is replaced by the n-th argument in one pass
 			template<typename... Args>
 			static std::string Format(const std::string& input, Args... args)
 			{
-				std::string output = input;
-				FormatInternal(output, 0, args...);
-				return output;
+				return Format(input.c_str(), args...);
 			}
 
 			template<typename... Args>
@@ -100,7 +109,20 @@ namespace Logger
 				{
 					return std::string("");
 				}
-				return Format(std::string(input), args...);
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				std::string output;
+				Append(output, input, arguments, sizeof...(Args));
+				return output;
+			}
+
+			// uses the text in the current language that has been parsed only once
+			template<typename... Args>
+			static std::string Format(const Languages::TextSelector text, Args... args)
+			{
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				std::string output;
+				Append(output, Template(text), arguments, sizeof...(Args));
+				return output;
 			}
 
 			template<typename... Args> void Error(const Languages::TextSelector text, Args... args)
@@ -109,7 +131,8 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Error", Languages::GetText(text), args...);
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				Log("Error", Template(text), arguments, sizeof...(Args));
 			}
 
 			template<typename... Args> void Warning(const Languages::TextSelector text, Args... args)
@@ -118,7 +141,8 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Warning", Languages::GetText(text), args...);
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				Log("Warning", Template(text), arguments, sizeof...(Args));
 			}
 
 			template<typename... Args> void Info(const Languages::TextSelector text, Args... args)
@@ -127,12 +151,18 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Info", Languages::GetText(text), args...);
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				Log("Info", Template(text), arguments, sizeof...(Args));
 			}
 
 			template<typename... Args> void Debug(const Languages::TextSelector text, Args... args)
 			{
-				Debug(Languages::GetText(text), args...);
+				if (logLevel < LevelDebug)
+				{
+					return;
+				}
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				Log("Debug", Template(text), arguments, sizeof...(Args));
 			}
 
 			template<typename... Args> void Debug(const std::string& text, Args... args)
@@ -141,58 +171,84 @@ namespace Logger
 				{
 					return;
 				}
-				Log("Debug", text, args...);
+				const std::string arguments[sizeof...(Args) + 1] = { ToString(args)... };
+				Log("Debug", text.c_str(), arguments, sizeof...(Args));
 			}
 
 			void Hex(const std::string& input) { Hex(reinterpret_cast<const unsigned char*>(input.c_str()), input.size()); }
-			void Hex(const unsigned char* input, const size_t size);
+			void Hex(const unsigned char* input, const size_t size)
+			{
+				if (logLevel < LevelDebug)
+				{
+					return;
+				}
+				HexDump(input, size);
+			}
+
+			// frames exchanged with the hardware are written to the packet capture if enabled and as hex dump to the debug log
+			void Received(const std::string& input) { Received(reinterpret_cast<const unsigned char*>(input.c_str()), input.size()); }
+			void Received(const unsigned char* input, const size_t size)
+			{
+				Capture(PacketCapture::DirectionReceived, input, size);
+				Hex(input, size);
+			}
+
+			void Sent(const unsigned char* input, const size_t size)
+			{
+				Capture(PacketCapture::DirectionSent, input, size);
+				Hex(input, size);
+			}
 
 
 		private:
 			static Level logLevel;
 			LoggerServer& server;
 			const std::string component;
+			// created with the first frame, so components that never exchange frames do not open a file
+			PacketCapture* capture;
+			std::mutex captureMutex;
 
-			static void AsciiPart(std::stringstream& output, const unsigned char* input, const size_t size);
-			static std::string DateTime();
-
-			static void Replace(std::string& workString, const unsigned char argument, const std::string& value);
-			static void Replace(std::string& workString, const unsigned char argument, char* value)
-			{
-				const char* constValue = value;
-				Replace(workString, argument, std::string(constValue));
-			}
-			static void Replace(std::string& workString, const unsigned char argument, const char* value)
+			void Capture(const PacketCapture::Direction direction, const unsigned char* input, const size_t size)
 			{
-				Replace(workString, argument, std::string(value == nullptr ? "" : value));
-			}
-			template<typename T>
-			static void Replace(std::string& workString, const unsigned char argument, T value)
-			{
-				Replace(workString, argument, std::to_string(value));
+				if (server.IsPacketCaptureEnabled() == false)
+				{
+					return;
+				}
+				std::lock_guard<std::mutex> guard(captureMutex);
+				if (capture == nullptr)
+				{
+					capture = new PacketCapture(PacketCapture::FileName(component));
+				}
+				capture->Write(direction, input, size);
 			}
 
-			template<typename T>
-			static void FormatInternal(std::string& workString,
-				const unsigned char argument,
-				T value)
-			{
-				Replace(workString, argument, value);
-			}
+			void HexDump(const unsigned char* input, const size_t size);
+			static std::string DateTime();
 
-			template<typename T, typename... Args>
-			static void FormatInternal(std::string& workString,
-				const unsigned char argument,
-				T value,
-				Args... args)
+			// part of a text, either literal text or a placeholder {n}
+			struct Segment
 			{
-				Replace(workString, argument, value);
-				FormatInternal(workString, argument + 1, args...);
-			}
+				const char* text;
+				size_t length;
+				unsigned char argument;
+			};
+			static const unsigned char NoArgument = 0xFF;
 
-			template<typename... Args> void Log(const std::string& type, const std::string& text, Args... args)
-			{
-				server.Send(DateTime() + ": " + type + ": " + component + ": " + Format(text, args...) + "\n");
-			}
+			static const std::string& ToString(const std::string& value) { return value; }
+			static std::string ToString(const char* value) { return std::string(value == nullptr ? "" : value); }
+			static std::string ToString(char* value) { const char* constValue = value; return ToString(constValue); }
+			template<typename T>
+			static std::string ToString(T value) { return std::to_string(value); }
+
+			// returns the length of the placeholder at input or 0 if there is none
+			static size_t Placeholder(const char* input, unsigned char& argument);
+			static std::vector<Segment> Parse(const char* input);
+			static std::vector<std::vector<Segment>> ParseAllTexts();
+			static const std::vector<Segment>& Template(const Languages::TextSelector text);
+			static void Append(std::string& output, const char* input, const std::string* arguments, const size_t count);
+			static void Append(std::string& output, const std::vector<Segment>& segments, const std::string* arguments, const size_t count);
+
+			void Log(const char* type, const std::vector<Segment>& segments, const std::string* arguments, const size_t count);
+			void Log(const char* type, const char* text, const std::string* arguments, const size_t count);
 	};
 }
@@ -30,5 +30,10 @@ namespace Logger
 			virtual ~LoggerClient() {}
 
 			virtual void Send(const std::string& s) = 0;
+
+			virtual bool IsConnected() const
+			{
+				return true;
+			}
 	};
 }
@@ -34,17 +34,18 @@ namespace Logger
 			:	connection(connection)
 			{}
 
-			~LoggerClientTcp()
+			void Send(const std::string& s) override
 			{
-				connection->Terminate();
+				connection->Send(s);
 			}
 
-			void Send(const std::string& s) override
+			bool IsConnected() const override
 			{
-				connection->Send(s);
+				return connection->IsConnected();
 			}
 
 		private:
+			// owned by the tcp server of the logger server
 			Network::TcpConnection* connection;
 	};
 }
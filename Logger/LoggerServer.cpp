@@ -18,6 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
 #include <iostream>
 
 #include "Logger/Logger.h"
@@ -28,6 +29,24 @@ using std::string;
 
 namespace Logger
 {
+	LoggerServer::LoggerServer()
+	:	Network::TcpServer(defaultLoggerPort, "Logger"),
+		run(true),
+		fileLoggerStarted(false),
+		consoleLoggerStarted(false),
+		packetCapture(false),
+		queueSize(DefaultQueueSize),
+		flushInterval(DefaultFlushInterval),
+		writtenMessages(0),
+		droppedMessages(0),
+		logger(nullptr)
+	{
+		queue.reserve(queueSize);
+		logger = GetLogger("Logger");
+		writerThread = std::thread(&LoggerServer::Writer, this);
+		StartTcpServer(1);
+	}
+
 	LoggerServer::~LoggerServer()
 	{
 		if (run == false)
@@ -35,9 +54,16 @@ namespace Logger
 			return;
 		}
 
-		run = false;
+		{
+			std::lock_guard<std::mutex> guard(queueMutex);
+			run = false;
+		}
+		queueCondition.notify_one();
+		writerThread.join();
+		TerminateTcpServer();
 
 		// delete all client memory
+		std::lock_guard<std::mutex> guard(clientsMutex);
 		while (clients.size() > 0)
 		{
 			LoggerClient* client = clients.back();
@@ -68,11 +94,108 @@ namespace Logger
 		return logger;
 	}
 
-	void LoggerServer::Send(const std::string& text)
+	void LoggerServer::Send(string text)
 	{
-		for(auto client : clients)
+		bool wakeWriter;
+		{
+			std::lock_guard<std::mutex> guard(queueMutex);
+			if (queue.size() >= queueSize)
+			{
+				++droppedMessages;
+				return;
+			}
+			queue.push_back(std::move(text));
+			// the writer is woken up early if the queue gets filled faster than the flush interval
+			wakeWriter = queue.size() == queueSize / 2;
+		}
+		if (wakeWriter)
+		{
+			queueCondition.notify_one();
+		}
+	}
+
+	void LoggerServer::Configure(const unsigned int queueSize, const unsigned int flushInterval)
+	{
+		std::lock_guard<std::mutex> guard(queueMutex);
+		// the writer is woken at half of the queue size, so the queue must hold at least two messages
+		this->queueSize = queueSize > 1 ? queueSize : 2;
+		this->flushInterval = flushInterval > 0 ? flushInterval : 1;
+		queue.reserve(this->queueSize);
+	}
+
+	unsigned int LoggerServer::GetWrittenMessages()
+	{
+		std::lock_guard<std::mutex> guard(queueMutex);
+		return writtenMessages;
+	}
+
+	unsigned int LoggerServer::GetDroppedMessages()
+	{
+		std::lock_guard<std::mutex> guard(queueMutex);
+		return droppedMessages;
+	}
+
+	void LoggerServer::Writer()
+	{
+		Utils::Utils::SetThreadName("Logger Writer");
+		std::vector<string> writing;
+		string batch;
+		unsigned int droppedReported = 0;
+		bool running = true;
+		while (running)
+		{
+			unsigned int dropped;
+			{
+				std::unique_lock<std::mutex> lock(queueMutex);
+				queueCondition.wait_for(lock, std::chrono::milliseconds(flushInterval), [this] { return run == false || queue.size() >= queueSize / 2; });
+				writing.swap(queue);
+				queue.reserve(queueSize);
+				writtenMessages += writing.size();
+				dropped = droppedMessages - droppedReported;
+				droppedReported = droppedMessages;
+				running = run;
+			}
+
+			if (writing.size() > 0)
+			{
+				batch.clear();
+				for (auto& text : writing)
+				{
+					batch += text;
+				}
+				writing.clear();
+				Write(batch);
+			}
+
+			if (dropped > 0)
+			{
+				// is written with the next batch
+				logger->Warning(Languages::TextLogMessagesDropped, dropped);
+			}
+		}
+	}
+
+	void LoggerServer::Write(const string& text)
+	{
+		std::lock_guard<std::mutex> guard(clientsMutex);
+		for (auto client : clients)
 		{
 			client->Send(text);
 		}
+		ReapClients();
+	}
+
+	void LoggerServer::ReapClients()
+	{
+		for (auto client = clients.begin(); client != clients.end();)
+		{
+			if ((*client)->IsConnected())
+			{
+				++client;
+				continue;
+			}
+			delete *client;
+			client = clients.erase(client);
+		}
 	}
 }
@@ -20,8 +20,12 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <cerrno>
+#include <condition_variable>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "Logger/LoggerClient.h"
@@ -41,7 +45,21 @@ namespace Logger
 			void operator=(LoggerServer const &) = delete;
 
 			Logger* GetLogger(const std::string& component);
-			void Send(const std::string& text);
+
+			// queues text for the writer thread, never waits for the clients
+			// if the queue is full the text is dropped and counted
+			void Send(std::string text);
+
+			// queueSize is the maximum number of messages waiting for the writer thread (at least 2),
+			// flushInterval the maximum time in milliseconds a message waits
+			void Configure(const unsigned int queueSize, const unsigned int flushInterval);
+
+			// loggers created afterwards write the frames exchanged with the hardware to railcontrol_<component>.pcap
+			void EnablePacketCapture(const bool enable) { packetCapture = enable; }
+			bool IsPacketCaptureEnabled() const { return packetCapture; }
+
+			unsigned int GetWrittenMessages();
+			unsigned int GetDroppedMessages();
 
 			static const unsigned short defaultLoggerPort = 2223;
 			static LoggerServer& Instance()
@@ -56,6 +74,7 @@ namespace Logger
 				{
 					return;
 				}
+				std::lock_guard<std::mutex> guard(clientsMutex);
 				clients.push_back(new LoggerClientFile(fileName));
 				fileLoggerStarted = true;
 			}
@@ -66,31 +85,64 @@ namespace Logger
 				{
 					return;
 				}
+				std::lock_guard<std::mutex> guard(clientsMutex);
 				clients.push_back(new LoggerClientConsole());
 				consoleLoggerStarted = true;
 			}
 
 		private:
-			LoggerServer()
-			:	Network::TcpServer(defaultLoggerPort, "Logger"),
-			 	run(true),
-			 	fileLoggerStarted(false),
-			 	consoleLoggerStarted(false)
+			LoggerServer();
+			~LoggerServer();
+
+			void Writer();
+			void Write(const std::string& text);
+
+			bool Connected(Network::TcpConnection* connection) override
 			{
+				std::lock_guard<std::mutex> guard(clientsMutex);
+				clients.push_back(new LoggerClientTcp(connection));
+				return true;
 			}
 
-			~LoggerServer();
+			// the clients only receive log messages, everything they send is ignored
+			bool Work(Network::TcpConnection* connection) override
+			{
+				char buffer[64];
+				return connection->Receive(buffer, sizeof(buffer)) >= 0 || errno == ETIMEDOUT;
+			}
 
-			void Work(Network::TcpConnection* connection) override
+			void Disconnected(Network::TcpConnection* connection) override
 			{
-				clients.push_back(new LoggerClientTcp(connection));
+				std::lock_guard<std::mutex> guard(clientsMutex);
+				connection->Terminate();
+				ReapClients();
 			}
 
+			// deletes all clients that have closed the connection, clientsMutex has to be locked by caller
+			void ReapClients();
+
 
 			volatile bool run;
 			bool fileLoggerStarted;
 			bool consoleLoggerStarted;
+			bool packetCapture;
 			std::vector<LoggerClient*> clients;
+			std::mutex clientsMutex;
 			std::vector<Logger*> loggers;
+
+			// messages are collected in queue, the writer thread swaps it with an empty one
+			// and writes all collected messages at once to every client
+			std::vector<std::string> queue;
+			std::mutex queueMutex;
+			std::condition_variable queueCondition;
+			unsigned int queueSize;
+			unsigned int flushInterval;
+			unsigned int writtenMessages;
+			unsigned int droppedMessages;
+			Logger* logger;
+			std::thread writerThread;
+
+			static const unsigned int DefaultQueueSize = 4096;
+			static const unsigned int DefaultFlushInterval = 100; // milliseconds
 	};
 }
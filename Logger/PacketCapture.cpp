@@ -0,0 +1,80 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Logger/PacketCapture.h"
+
+using std::string;
+
+namespace Logger
+{
+	PacketCapture::PacketCapture(const string& fileName)
+	:	startMicroseconds(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count()),
+		steadyStart(std::chrono::steady_clock::now())
+	{
+		file.open(fileName, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+		if (file.is_open() == false)
+		{
+			return;
+		}
+		const FileHeader header = { Magic, VersionMajor, VersionMinor, 0, 0, SnapLength, LinkTypeUser0 };
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+
+	PacketCapture::~PacketCapture()
+	{
+		std::lock_guard<std::mutex> guard(fileMutex);
+		if (file.is_open() == false)
+		{
+			return;
+		}
+		file.close();
+	}
+
+	void PacketCapture::Write(const Direction direction, const unsigned char* data, const size_t size)
+	{
+		const uint64_t timestamp = startMicroseconds + std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - steadyStart).count();
+		const uint32_t originalLength = static_cast<uint32_t>(size + 1);
+		const uint32_t capturedLength = originalLength < SnapLength ? originalLength : SnapLength;
+		const RecordHeader header = { static_cast<uint32_t>(timestamp / 1000000), static_cast<uint32_t>(timestamp % 1000000), capturedLength, originalLength };
+
+		std::lock_guard<std::mutex> guard(fileMutex);
+		if (file.is_open() == false)
+		{
+			return;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.put(static_cast<char>(direction));
+		file.write(reinterpret_cast<const char*>(data), capturedLength - 1);
+		// a frame must be complete on disk even if railcontrol gets killed
+		file.flush();
+	}
+
+	string PacketCapture::FileName(const string& component)
+	{
+		string fileName("railcontrol_");
+		for (auto c : component)
+		{
+			const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-';
+			fileName.push_back(valid ? c : '_');
+		}
+		fileName.append(".pcap");
+		return fileName;
+	}
+}
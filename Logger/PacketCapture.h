@@ -0,0 +1,88 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace Logger
+{
+	// writes raw frames to a pcap file with link type USER0 that can be read by wireshark or tcpdump
+	// every frame is prefixed by one byte with its direction
+	// the timestamps are the wall clock time of opening the file plus the steady clock time elapsed since then,
+	// so a clock step during the capture does not show up as a gap between the frames
+	class PacketCapture
+	{
+		public:
+			enum Direction : unsigned char
+			{
+				DirectionReceived = 0,
+				DirectionSent = 1
+			};
+
+			PacketCapture(const std::string& fileName);
+			~PacketCapture();
+
+			PacketCapture(const PacketCapture&) = delete;
+			PacketCapture& operator=(const PacketCapture&) = delete;
+
+			bool IsOpen() const { return file.is_open(); }
+
+			void Write(const Direction direction, const unsigned char* data, const size_t size);
+
+			// returns a file name for the captures of component that is safe for the file system
+			static std::string FileName(const std::string& component);
+
+			static const uint32_t Magic = 0xa1b2c3d4;
+			static const uint16_t VersionMajor = 2;
+			static const uint16_t VersionMinor = 4;
+			static const uint32_t SnapLength = 65535;
+			static const uint32_t LinkTypeUser0 = 147;
+
+			struct FileHeader
+			{
+				uint32_t magic;
+				uint16_t versionMajor;
+				uint16_t versionMinor;
+				int32_t timeZone;
+				uint32_t timestampAccuracy;
+				uint32_t snapLength;
+				uint32_t linkType;
+			};
+
+			struct RecordHeader
+			{
+				uint32_t seconds;
+				uint32_t microseconds;
+				uint32_t capturedLength;
+				uint32_t originalLength;
+			};
+
+		private:
+			std::ofstream file;
+			std::mutex fileMutex;
+			uint64_t startMicroseconds;
+			std::chrono::steady_clock::time_point steadyStart;
+	};
+}
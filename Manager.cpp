@@ -18,6 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <deque>
 #include <future>
 #include <iostream>
 #include <sstream>
@@ -58,6 +59,9 @@ Manager::Manager(Config& config)
 	run(false),
 	debounceRun(false),
 	initLocosDone(false),
+	initLocosRunning(false),
+	initLocosAgain(false),
+	locoScheduler(config.getValue("automodeworkers", 4), config.getValue("automoderetryinterval", 1000)),
 	unknownControl(Languages::GetText(Languages::TextControlDoesNotExist)),
 	unknownLoco(Languages::GetText(Languages::TextLocoDoesNotExist)),
 	unknownAccessory(Languages::GetText(Languages::TextAccessoryDoesNotExist)),
@@ -67,6 +71,9 @@ Manager::Manager(Config& config)
 	unknownRoute(Languages::GetText(Languages::TextRouteDoesNotExist)),
 	unknownSignal(Languages::GetText(Languages::TextSignalDoesNotExist))
 {
+	Logger::LoggerServer::Instance().Configure(config.getValue("logqueuesize", 4096), config.getValue("logflushinterval", 100));
+	Logger::LoggerServer::Instance().EnablePacketCapture(config.getValue("packetcapture", 0) != 0);
+
 	StorageParams storageParams;
 	storageParams.module = "Sqlite";
 	storageParams.filename = config.getValue("dbfilename", "railcontrol.sqlite");
@@ -86,7 +93,7 @@ Manager::Manager(Config& config)
 	selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::StringToInteger(storage->GetSetting("SelectRouteApproach")));
 	nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(Utils::Utils::StringToInteger(storage->GetSetting("NrOfTracksToReserve"), 2));
 
-	controls[ControlIdWebserver] = new WebServer::WebServer(*this, config.getValue("webserverport", 8080));
+	controls[ControlIdWebserver] = new WebServer::WebServer(*this, config.getValue("webserverport", 8080), config.getValue("webserverupdates", 100), config.getValue("webservermaxclients", 64), config.getValue("webserverworkers", 4), config.getValue("webserverwatchfiles", 1) != 0);
 
 	storage->AllHardwareParams(hardwareParams);
 	for (auto hardwareParam : hardwareParams)
@@ -124,12 +131,20 @@ Manager::Manager(Config& config)
 		}
 		logger->Info(Languages::TextLoadedAccessory, accessory.second->GetID(), accessory.second->GetName());
 	}
+	IndexBuild(accessoriesByHardware, accessories);
+	LayoutIndexBuild(accessories);
 
 	storage->AllFeedbacks(feedbacks);
 	for (auto feedback : feedbacks)
 	{
 		logger->Info(Languages::TextLoadedFeedback, feedback.second->GetID(), feedback.second->GetName());
 	}
+	IndexBuild(feedbacksByHardware, feedbacks);
+	for (auto feedback : feedbacks)
+	{
+		feedbacksByControl[feedback.second->GetControlID()][feedback.first] = feedback.second;
+	}
+	LayoutIndexBuild(feedbacks);
 
 	storage->AllSignals(signals);
 	for (auto signal : signals)
@@ -144,12 +159,15 @@ Manager::Manager(Config& config)
 		}
 		logger->Info(Languages::TextLoadedSignal, signal.second->GetID(), signal.second->GetName());
 	}
+	IndexBuild(signalsByHardware, signals);
+	LayoutIndexBuild(signals);
 
 	storage->AllTracks(tracks);
 	for (auto track : tracks)
 	{
 		logger->Info(Languages::TextLoadedTrack, track.second->GetID(), track.second->GetName());
 	}
+	LayoutIndexBuild(tracks);
 
 	storage->AllSwitches(switches);
 	for (auto mySwitch : switches)
@@ -164,6 +182,8 @@ Manager::Manager(Config& config)
 		}
 		logger->Info(Languages::TextLoadedSwitch, mySwitch.second->GetID(), mySwitch.second->GetName());
 	}
+	IndexBuild(switchesByHardware, switches);
+	LayoutIndexBuild(switches);
 
 	storage->AllClusters(clusters);
 	for (auto cluster : clusters)
@@ -176,6 +196,7 @@ Manager::Manager(Config& config)
 	{
 		logger->Info(Languages::TextLoadedRoute, route.second->GetID(), route.second->GetName());
 	}
+	LayoutIndexBuild(routes);
 
 	storage->AllLocos(locos);
 	for (auto loco : locos)
@@ -190,11 +211,12 @@ Manager::Manager(Config& config)
 		}
 		logger->Info(Languages::TextLoadedLoco, loco.second->GetID(), loco.second->GetName());
 	}
+	IndexBuild(locosByHardware, locos);
 
 	run = true;
 	debounceRun = true;
 	debounceThread = std::thread(&Manager::DebounceWorker, this);
-	InitLocos();
+	StartInitLocos();
 }
 
 Manager::~Manager()
@@ -204,12 +226,22 @@ Manager::~Manager()
 		Utils::Utils::SleepForSeconds(1);
 	}
 
-	debounceRun = false;
+	{
+		std::lock_guard<std::mutex> guard(debounceMutex);
+		debounceRun = false;
+	}
+	debounceCondition.notify_one();
 	debounceThread.join();
 
+	locoScheduler.Terminate();
+
 	Booster(ControlTypeInternal, BoosterStateStop);
 
 	run = false;
+	if (initLocosThread.joinable())
+	{
+		initLocosThread.join();
+	}
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
 		for (auto control : controls)
@@ -285,27 +317,138 @@ void Manager::Booster(const ControlType controlType, const BoosterState state)
 		}
 	}
 
+	if (boosterState == BoosterStateGo)
+	{
+		// locos in automode do not search routes while the booster is stopped
+		locoScheduler.WakeWaiting();
+	}
+
 	if (boosterState != BoosterStateGo || initLocosDone == true)
 	{
 		return;
 	}
 
-	std::async(std::launch::async, InitLocosStatic, this);
+	StartInitLocos();
 	initLocosDone = true;
 }
 
+void Manager::StartInitLocos()
+{
+	std::lock_guard<std::mutex> guard(initLocosMutex);
+	if (initLocosRunning)
+	{
+		// the running thread sends all locos again when it has finished
+		initLocosAgain = true;
+		return;
+	}
+	if (initLocosThread.joinable())
+	{
+		initLocosThread.join();
+	}
+	initLocosRunning = true;
+	initLocosThread = std::thread(&Manager::InitLocos, this);
+}
+
 void Manager::InitLocos()
 {
+	Utils::Utils::SetThreadName("InitLocos");
 	Utils::Utils::SleepForSeconds(1);
-	std::lock_guard<std::mutex> guard(locoMutex);
-	for (auto loco : locos)
+	while (true)
 	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
+		SendLocoStates();
+		std::lock_guard<std::mutex> guard(initLocosMutex);
+		if (initLocosAgain == false || run == false)
 		{
-			std::vector<DataModel::LocoFunctionEntry> functions = loco.second->GetFunctionStates();
-			control.second->LocoSpeedOrientationFunctions(loco.second, loco.second->GetSpeed(), loco.second->GetOrientation(), functions);
+			initLocosRunning = false;
+			return;
 		}
+		initLocosAgain = false;
+	}
+}
+
+void Manager::SendLocoStates()
+{
+	std::map<ControlID,std::deque<LocoID>> waitingLocos;
+	unsigned int total = 0;
+	{
+		std::lock_guard<std::mutex> guard(locoMutex);
+		for (auto loco : locos)
+		{
+			waitingLocos[loco.second->GetControlID()].push_back(loco.first);
+			++total;
+		}
+	}
+
+	// every control gets the next loco as soon as it has sent the commands of the previous one,
+	// so the controls work in parallel and commands of the user do not wait behind all locos
+	unsigned int sent = 0;
+	while (run && !waitingLocos.empty())
+	{
+		bool anySent = false;
+		for (auto waiting = waitingLocos.begin(); waiting != waitingLocos.end(); )
+		{
+			const ControlID controlID = waiting->first;
+			{
+				std::lock_guard<std::mutex> guard(controlMutex);
+				auto control = controls.find(controlID);
+				if (control == controls.end())
+				{
+					sent += waiting->second.size();
+					waiting = waitingLocos.erase(waiting);
+					continue;
+				}
+				if (control->second->PendingCommands() > 0)
+				{
+					++waiting;
+					continue;
+				}
+			}
+
+			const LocoID locoID = waiting->second.front();
+			waiting->second.pop_front();
+			{
+				std::lock_guard<std::mutex> guard(locoMutex);
+				auto loco = locos.find(locoID);
+				if (loco != locos.end())
+				{
+					std::vector<DataModel::LocoFunctionEntry> functions = loco->second->GetFunctionStates();
+					std::lock_guard<std::mutex> guard(controlMutex);
+					auto control = controls.find(controlID);
+					if (control != controls.end())
+					{
+						control->second->LocoSpeedOrientationFunctions(loco->second, loco->second->GetSpeed(), loco->second->GetOrientation(), functions);
+					}
+				}
+			}
+			++sent;
+			anySent = true;
+			// report every tenth part
+			if ((sent * 10 / total) != ((sent - 1) * 10 / total))
+			{
+				LocoStatesSent(sent, total);
+			}
+
+			if (waiting->second.empty())
+			{
+				waiting = waitingLocos.erase(waiting);
+				continue;
+			}
+			++waiting;
+		}
+		if (!anySent)
+		{
+			Utils::Utils::SleepForMilliseconds(10);
+		}
+	}
+}
+
+void Manager::LocoStatesSent(const unsigned int sent, const unsigned int total)
+{
+	logger->Info(Languages::TextLocoStatesSent, sent, total);
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto control : controls)
+	{
+		control.second->LocoStatesSent(sent, total);
 	}
 }
 
@@ -465,6 +608,16 @@ ControlInterface* Manager::GetControl(const ControlID controlID) const
 	return controls.at(controlID);
 }
 
+bool Manager::ControlCommandStatistics(const ControlID controlID, unsigned int& sent, unsigned int& superseded, unsigned int& immediately)
+{
+	std::lock_guard<std::mutex> guard(controlMutex);
+	if (controls.count(controlID) != 1)
+	{
+		return false;
+	}
+	return controls.at(controlID)->CommandStatistics(sent, superseded, immediately);
+}
+
 const std::string Manager::GetControlName(const ControlID controlID)
 {
 	std::lock_guard<std::mutex> guard(controlMutex);
@@ -615,16 +768,12 @@ DataModel::Loco* Manager::GetLoco(const LocoID locoID) const
 Loco* Manager::GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(locoMutex);
-	for (auto loco : locos)
+	auto entry = locosByHardware.find(IndexKey(controlID, protocol, address));
+	if (entry == locosByHardware.end())
 	{
-		if (loco.second->GetControlID() == controlID
-			&& loco.second->GetProtocol() == protocol
-			&& loco.second->GetAddress() == address)
-		{
-			return loco.second;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return entry->second;
 }
 
 const std::string& Manager::GetLocoName(const LocoID locoID) const
@@ -695,9 +844,14 @@ bool Manager::LocoSave(const LocoID locoID,
 	}
 
 	loco->SetName(CheckObjectName(locos, locoMutex, locoID, name.size() == 0 ? "L" : name));
-	loco->SetControlID(controlID);
-	loco->SetProtocol(protocol);
-	loco->SetAddress(address);
+	{
+		std::lock_guard<std::mutex> guard(locoMutex);
+		const HardwareIndexKey oldKey = IndexKey(loco);
+		loco->SetControlID(controlID);
+		loco->SetProtocol(protocol);
+		loco->SetAddress(address);
+		IndexUpdate(locosByHardware, locos, oldKey, loco);
+	}
 	loco->SetLength(length);
 	loco->SetPushpull(pushpull);
 	loco->SetMaxSpeed(maxSpeed);
@@ -741,11 +895,12 @@ bool Manager::LocoDelete(const LocoID locoID, string& result)
 
 		if (loco->IsInUse())
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLocoIsInUse), loco->GetName());
+			result = Logger::Logger::Format(Languages::TextLocoIsInUse, loco->GetName());
 			return false;
 		}
 
 		locos.erase(locoID);
+		IndexRemove(locosByHardware, locos, IndexKey(loco), loco);
 	}
 
 	if (storage)
@@ -979,16 +1134,12 @@ Accessory* Manager::GetAccessory(const AccessoryID accessoryID) const
 Accessory* Manager::GetAccessory(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(accessoryMutex);
-	for (auto accessory : accessories)
+	auto entry = accessoriesByHardware.find(IndexKey(controlID, protocol, address));
+	if (entry == accessoriesByHardware.end())
 	{
-		if (accessory.second->GetControlID() == controlID
-			&& accessory.second->GetProtocol() == protocol
-			&& accessory.second->GetAddress() == address)
-		{
-			return accessory.second;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return entry->second;
 }
 
 const std::string& Manager::GetAccessoryName(const AccessoryID accessoryID) const
@@ -1041,12 +1192,22 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 
 	// update existing accessory
 	accessory->SetName(CheckObjectName(accessories, accessoryMutex, accessoryID, name.size() == 0 ? "A" : name));
-	accessory->SetPosX(posX);
-	accessory->SetPosY(posY);
-	accessory->SetPosZ(posZ);
-	accessory->SetControlID(controlID);
-	accessory->SetProtocol(protocol);
-	accessory->SetAddress(address);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(accessory);
+		accessory->SetPosX(posX);
+		accessory->SetPosY(posY);
+		accessory->SetPosZ(posZ);
+		LayoutIndexAdd(accessory);
+	}
+	{
+		std::lock_guard<std::mutex> guard(accessoryMutex);
+		const HardwareIndexKey oldKey = IndexKey(accessory);
+		accessory->SetControlID(controlID);
+		accessory->SetProtocol(protocol);
+		accessory->SetAddress(address);
+		IndexUpdate(accessoriesByHardware, accessories, oldKey, accessory);
+	}
 	accessory->SetType(type);
 	accessory->SetAccessoryPulseDuration(duration);
 	accessory->SetInverted(inverted);
@@ -1102,6 +1263,11 @@ bool Manager::AccessoryDelete(const AccessoryID accessoryID,
 		}
 
 		accessories.erase(accessoryID);
+		IndexRemove(accessoriesByHardware, accessories, IndexKey(accessory), accessory);
+	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(accessory);
 	}
 
 	if (storage)
@@ -1150,7 +1316,7 @@ void Manager::FeedbackState(const ControlID controlID, const FeedbackPin pin, co
 	logger->Info(Languages::TextAddingFeedback, name);
 	string result;
 
-	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, controlID, pin, false, result);
+	FeedbackSave(FeedbackNone, name, DataModel::LayoutItem::VisibleNo, 0, 0, 0, controlID, pin, false, DataModel::Feedback::DefaultDebounceTime, result);
 }
 
 void Manager::FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state)
@@ -1182,6 +1348,15 @@ void Manager::FeedbackPublishState(const Feedback* feedback)
 	}
 }
 
+void Manager::FeedbackDebounce(const FeedbackID feedbackID, const DataModel::Feedback::DebounceDeadline deadline)
+{
+	{
+		std::lock_guard<std::mutex> guard(debounceMutex);
+		debounceQueue.emplace(deadline, feedbackID);
+	}
+	debounceCondition.notify_one();
+}
+
 Feedback* Manager::GetFeedback(const FeedbackID feedbackID) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
@@ -1200,15 +1375,12 @@ Feedback* Manager::GetFeedbackUnlocked(const FeedbackID feedbackID) const
 Feedback* Manager::GetFeedback(const ControlID controlID, const FeedbackPin pin) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
-	for (auto feedback : feedbacks)
+	auto entry = feedbacksByHardware.find(IndexKey(controlID, pin));
+	if (entry == feedbacksByHardware.end())
 	{
-		if (feedback.second->GetControlID() == controlID
-			&& feedback.second->GetPin() == pin)
-		{
-			return feedback.second;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return entry->second;
 }
 
 const std::string& Manager::GetFeedbackName(const FeedbackID feedbackID) const
@@ -1240,7 +1412,7 @@ bool Manager::CheckFeedbackPosition(const Feedback* feedback, const LayoutPositi
 	return CheckPositionFree(posX, posY, posZ, DataModel::LayoutItem::Width1, DataModel::LayoutItem::Height1, DataModel::LayoutItem::Rotation0, result);
 }
 
-bool Manager::FeedbackSave(const FeedbackID feedbackID, const std::string& name, const Visible visible, const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, string& result)
+bool Manager::FeedbackSave(const FeedbackID feedbackID, const std::string& name, const Visible visible, const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, const DataModel::Feedback::DebounceTime debounceTime, string& result)
 {
 	Feedback* feedback = GetFeedback(feedbackID);
 	if (visible && !CheckFeedbackPosition(feedback, posX, posY, posZ, result))
@@ -1260,13 +1432,26 @@ bool Manager::FeedbackSave(const FeedbackID feedbackID, const std::string& name,
 	}
 
 	feedback->SetName(CheckObjectName(feedbacks, feedbackMutex, feedbackID, name.size() == 0 ? "F" : name));
-	feedback->SetVisible(visible);
-	feedback->SetPosX(posX);
-	feedback->SetPosY(posY);
-	feedback->SetPosZ(posZ);
-	feedback->SetControlID(controlID);
-	feedback->SetPin(pin);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(feedback);
+		feedback->SetVisible(visible);
+		feedback->SetPosX(posX);
+		feedback->SetPosY(posY);
+		feedback->SetPosZ(posZ);
+		LayoutIndexAdd(feedback);
+	}
+	{
+		std::lock_guard<std::mutex> guard(feedbackMutex);
+		const FeedbackIndexKey oldKey = IndexKey(feedback);
+		feedbacksByControl[feedback->GetControlID()].erase(feedback->GetID());
+		feedback->SetControlID(controlID);
+		feedback->SetPin(pin);
+		IndexUpdate(feedbacksByHardware, feedbacks, oldKey, feedback);
+		feedbacksByControl[controlID][feedback->GetID()] = feedback;
+	}
 	feedback->SetInverted(inverted);
+	feedback->SetDebounceTime(debounceTime);
 
 	// save in db
 	if (storage)
@@ -1293,6 +1478,23 @@ const map<string,DataModel::Feedback*> Manager::FeedbackListByName() const
 	return out;
 }
 
+const vector<const Feedback*> Manager::FeedbacksOfControl(const ControlID controlID) const
+{
+	vector<const Feedback*> out;
+	std::lock_guard<std::mutex> guard(feedbackMutex);
+	auto feedbacksOfControl = feedbacksByControl.find(controlID);
+	if (feedbacksOfControl == feedbacksByControl.end())
+	{
+		return out;
+	}
+	out.reserve(feedbacksOfControl->second.size());
+	for (auto feedback : feedbacksOfControl->second)
+	{
+		out.push_back(feedback.second);
+	}
+	return out;
+}
+
 const map<string,FeedbackID> Manager::FeedbacksOfTrack(const ObjectIdentifier& identifier) const
 {
 	map<string,FeedbackID> out;
@@ -1330,11 +1532,17 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 		TrackBase* trackBase = feedback->GetTrack();
 		if (trackBase != nullptr)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextFeedbackIsUsedByTrack), feedback->GetName(), trackBase->GetMyName());
+			result = Logger::Logger::Format(Languages::TextFeedbackIsUsedByTrack, feedback->GetName(), trackBase->GetMyName());
 			return false;
 		}
 
 		feedbacks.erase(feedbackID);
+		IndexRemove(feedbacksByHardware, feedbacks, IndexKey(feedback), feedback);
+		feedbacksByControl[feedback->GetControlID()].erase(feedbackID);
+	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(feedback);
 	}
 
 	if (storage)
@@ -1559,11 +1767,16 @@ bool Manager::TrackSave(const TrackID trackID,
 	// update existing track
 	track->SetName(CheckObjectName(tracks, trackMutex, trackID, name.size() == 0 ? "T" : name));
 	track->SetShowName(showName);
-	track->SetHeight(height);
-	track->SetRotation(rotation);
-	track->SetPosX(posX);
-	track->SetPosY(posY);
-	track->SetPosZ(posZ);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(track);
+		track->SetHeight(height);
+		track->SetRotation(rotation);
+		track->SetPosX(posX);
+		track->SetPosY(posY);
+		track->SetPosZ(posZ);
+		LayoutIndexAdd(track);
+	}
 	track->SetTrackType(trackType);
 	track->Feedbacks(CleanupAndCheckFeedbacksForTrack(ObjectIdentifier(ObjectTypeTrack, trackID), newFeedbacks));
 	track->AssignSignals(newSignals);
@@ -1606,14 +1819,14 @@ bool Manager::TrackDelete(const TrackID trackID,
 
 		if (track->IsInUse())
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextTrackIsUsedByLoco), track->GetName(), GetLocoName(track->GetLoco()));
+			result = Logger::Logger::Format(Languages::TextTrackIsUsedByLoco, track->GetName(), GetLocoName(track->GetLoco()));
 			return false;
 		}
 
 		Route* route = track->GetFirstRoute();
 		if (route != nullptr)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextTrackIsUsedByRoute), track->GetName(), route->GetName());
+			result = Logger::Logger::Format(Languages::TextTrackIsUsedByRoute, track->GetName(), route->GetName());
 			return false;
 		}
 
@@ -1621,7 +1834,7 @@ bool Manager::TrackDelete(const TrackID trackID,
 		route = GetFirstRouteToTrackBase(trackIdentifier);
 		if (route != nullptr)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextTrackIsUsedByRoute), track->GetName(), route->GetName());
+			result = Logger::Logger::Format(Languages::TextTrackIsUsedByRoute, track->GetName(), route->GetName());
 			return false;
 		}
 
@@ -1633,12 +1846,16 @@ bool Manager::TrackDelete(const TrackID trackID,
 		FeedbackID feedbackId = track->GetFirstFeedbackId();
 		if (feedbackId != FeedbackNone)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextTrackHasAssociatedFeedback), track->GetName(), GetFeedbackName(feedbackId));
+			result = Logger::Logger::Format(Languages::TextTrackHasAssociatedFeedback, track->GetName(), GetFeedbackName(feedbackId));
 			return false;
 		}
 
 		tracks.erase(trackID);
 	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(track);
+	}
 
 	if (storage)
 	{
@@ -1712,16 +1929,12 @@ Switch* Manager::GetSwitch(const SwitchID switchID) const
 Switch* Manager::GetSwitch(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(switchMutex);
-	for (auto mySwitch : switches)
+	auto entry = switchesByHardware.find(IndexKey(controlID, protocol, address));
+	if (entry == switchesByHardware.end())
 	{
-		if (mySwitch.second->GetControlID() == controlID
-			&& mySwitch.second->GetProtocol() == protocol
-			&& mySwitch.second->GetAddress() == address)
-		{
-			return mySwitch.second;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return entry->second;
 }
 
 const std::string& Manager::GetSwitchName(const SwitchID switchID) const
@@ -1784,13 +1997,23 @@ bool Manager::SwitchSave(const SwitchID switchID,
 
 	// update existing switch
 	mySwitch->SetName(CheckObjectName(switches, switchMutex, switchID, name.size() == 0 ? "S" : name));
-	mySwitch->SetPosX(posX);
-	mySwitch->SetPosY(posY);
-	mySwitch->SetPosZ(posZ);
-	mySwitch->SetRotation(rotation);
-	mySwitch->SetControlID(controlID);
-	mySwitch->SetProtocol(protocol);
-	mySwitch->SetAddress(address);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(mySwitch);
+		mySwitch->SetPosX(posX);
+		mySwitch->SetPosY(posY);
+		mySwitch->SetPosZ(posZ);
+		mySwitch->SetRotation(rotation);
+		LayoutIndexAdd(mySwitch);
+	}
+	{
+		std::lock_guard<std::mutex> guard(switchMutex);
+		const HardwareIndexKey oldKey = IndexKey(mySwitch);
+		mySwitch->SetControlID(controlID);
+		mySwitch->SetProtocol(protocol);
+		mySwitch->SetAddress(address);
+		IndexUpdate(switchesByHardware, switches, oldKey, mySwitch);
+	}
 	mySwitch->SetType(type);
 	mySwitch->SetAccessoryPulseDuration(duration);
 	mySwitch->SetInverted(inverted);
@@ -1834,6 +2057,11 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 			return false;
 		}
 		switches.erase(switchID);
+		IndexRemove(switchesByHardware, switches, IndexKey(mySwitch), mySwitch);
+	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(mySwitch);
 	}
 
 	if (storage)
@@ -2008,10 +2236,15 @@ bool Manager::RouteSave(const RouteID routeID,
 	route->SetDelay(delay);
 	route->AssignRelationsAtLock(relationsAtLock);
 	route->AssignRelationsAtUnlock(relationsAtUnlock);
-	route->SetVisible(visible);
-	route->SetPosX(posX);
-	route->SetPosY(posY);
-	route->SetPosZ(posZ);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(route);
+		route->SetVisible(visible);
+		route->SetPosX(posX);
+		route->SetPosY(posY);
+		route->SetPosZ(posZ);
+		LayoutIndexAdd(route);
+	}
 	route->SetAutomode(automode);
 	if (automode == AutomodeYes)
 	{
@@ -2116,7 +2349,7 @@ bool Manager::RouteDelete(const RouteID routeID,
 
 			if (route->IsInUse())
 			{
-				result = Logger::Logger::Format(Languages::GetText(Languages::TextRouteIsInUse), route->GetName());
+				result = Logger::Logger::Format(Languages::TextRouteIsInUse, route->GetName());
 				return false;
 			}
 		}
@@ -2134,6 +2367,16 @@ bool Manager::RouteDelete(const RouteID routeID,
 		}
 	}
 
+	TrackBase* track = GetTrackBase(route->GetFromTrack());
+	if (track != nullptr)
+	{
+		track->RemoveRoute(route);
+	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(route);
+	}
+
 	if (storage)
 	{
 		storage->DeleteRoute(routeID);
@@ -2237,7 +2480,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (track.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedByTrack), layer->GetName(), track.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedByTrack, layer->GetName(), track.second->GetName());
 			return true;
 		}
 	}
@@ -2245,7 +2488,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (mySwitch.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedBySwitch), layer->GetName(), mySwitch.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedBySwitch, layer->GetName(), mySwitch.second->GetName());
 			return true;
 		}
 	}
@@ -2253,7 +2496,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (signal.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedBySignal), layer->GetName(), signal.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedBySignal, layer->GetName(), signal.second->GetName());
 			return true;
 		}
 	}
@@ -2261,7 +2504,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (accessory.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedByAccessory), layer->GetName(), accessory.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedByAccessory, layer->GetName(), accessory.second->GetName());
 			return true;
 		}
 	}
@@ -2269,7 +2512,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (route.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedByRoute), layer->GetName(), route.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedByRoute, layer->GetName(), route.second->GetName());
 			return true;
 		}
 	}
@@ -2277,7 +2520,7 @@ bool Manager::LayerHasElements(const Layer* layer,
 	{
 		if (feedback.second->IsVisibleOnLayer(layerId))
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextLayerIsUsedByFeedback), layer->GetName(), feedback.second->GetName());
+			result = Logger::Logger::Format(Languages::TextLayerIsUsedByFeedback, layer->GetName(), feedback.second->GetName());
 			return true;
 		}
 	}
@@ -2397,16 +2640,12 @@ Signal* Manager::GetSignal(const SignalID signalID) const
 Signal* Manager::GetSignal(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(signalMutex);
-	for (auto signal : signals)
+	auto entry = signalsByHardware.find(IndexKey(controlID, protocol, address));
+	if (entry == signalsByHardware.end())
 	{
-		if (signal.second->GetControlID() == controlID
-			&& signal.second->GetProtocol() == protocol
-			&& signal.second->GetAddress() == address)
-		{
-			return signal.second;
-		}
+		return nullptr;
 	}
-	return nullptr;
+	return entry->second;
 }
 
 const std::string& Manager::GetSignalName(const SignalID signalID) const
@@ -2477,18 +2716,28 @@ bool Manager::SignalSave(const SignalID signalID,
 
 	signal->SetName(CheckObjectName(signals, signalMutex, signalID, name.size() == 0 ? "S" : name));
 	signal->SetSignalOrientation(signalOrientation);
-	signal->SetPosX(posX);
-	signal->SetPosY(posY);
-	signal->SetPosZ(posZ);
-	signal->SetHeight(height);
-	signal->SetRotation(rotation);
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(signal);
+		signal->SetPosX(posX);
+		signal->SetPosY(posY);
+		signal->SetPosZ(posZ);
+		signal->SetHeight(height);
+		signal->SetRotation(rotation);
+		LayoutIndexAdd(signal);
+	}
 	signal->Feedbacks(CleanupAndCheckFeedbacksForTrack(ObjectIdentifier(ObjectTypeSignal, signalID), newFeedbacks));
 	signal->SetSelectRouteApproach(selectRouteApproach);
 	signal->SetAllowLocoTurn(allowLocoTurn);
 	signal->SetReleaseWhenFree(releaseWhenFree);
-	signal->SetControlID(controlID);
-	signal->SetProtocol(protocol);
-	signal->SetAddress(address);
+	{
+		std::lock_guard<std::mutex> guard(signalMutex);
+		const HardwareIndexKey oldKey = IndexKey(signal);
+		signal->SetControlID(controlID);
+		signal->SetProtocol(protocol);
+		signal->SetAddress(address);
+		IndexUpdate(signalsByHardware, signals, oldKey, signal);
+	}
 	signal->SetType(type);
 	signal->SetAccessoryPulseDuration(duration);
 	signal->SetInverted(inverted);
@@ -2528,14 +2777,14 @@ bool Manager::SignalDelete(const SignalID signalID,
 
 		if (signal->IsInUse())
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextSignalIsUsedByLoco), signal->GetName(), GetLocoName(signal->GetLoco()));
+			result = Logger::Logger::Format(Languages::TextSignalIsUsedByLoco, signal->GetName(), GetLocoName(signal->GetLoco()));
 			return false;
 		}
 
 		Route* route = signal->GetFirstRoute();
 		if (route != nullptr)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextSignalIsUsedByRoute), signal->GetName(), route->GetName());
+			result = Logger::Logger::Format(Languages::TextSignalIsUsedByRoute, signal->GetName(), route->GetName());
 			return false;
 		}
 
@@ -2543,7 +2792,7 @@ bool Manager::SignalDelete(const SignalID signalID,
 		route = GetFirstRouteToTrackBase(signalIdentifier);
 		if (route != nullptr)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextSignalIsUsedByRoute), signal->GetName(), route->GetName());
+			result = Logger::Logger::Format(Languages::TextSignalIsUsedByRoute, signal->GetName(), route->GetName());
 			return false;
 		}
 
@@ -2555,12 +2804,17 @@ bool Manager::SignalDelete(const SignalID signalID,
 		FeedbackID feedbackId = signal->GetFirstFeedbackId();
 		if (feedbackId != FeedbackNone)
 		{
-			result = Logger::Logger::Format(Languages::GetText(Languages::TextSignalIsUsedByRoute), signal->GetName(), GetFeedbackName(feedbackId));
+			result = Logger::Logger::Format(Languages::TextSignalIsUsedByRoute, signal->GetName(), GetFeedbackName(feedbackId));
 			return false;
 		}
 
 		signal = signals.at(signalID);
 		signals.erase(signalID);
+		IndexRemove(signalsByHardware, signals, IndexKey(signal), signal);
+	}
+	{
+		std::lock_guard<std::mutex> guard(layoutMutex);
+		LayoutIndexRemove(signal);
 	}
 
 	if (storage)
@@ -3004,14 +3258,43 @@ void Manager::StopAllLocosImmediately(const ControlType controlType)
 * Layout                   *
 ***************************/
 
+const DataModel::LayoutItem* Manager::GetLayoutItem(const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ) const
+{
+	std::lock_guard<std::mutex> guard(layoutMutex);
+	auto entry = layoutCells.find(CellKey(posX, posY, posZ));
+	if (entry == layoutCells.end())
+	{
+		return nullptr;
+	}
+	return entry->second;
+}
+
+const vector<const DataModel::LayoutItem*> Manager::LayoutItemsOfLayer(const LayerID layer) const
+{
+	vector<const DataModel::LayoutItem*> out;
+	std::lock_guard<std::mutex> guard(layoutMutex);
+	auto items = layerItems.find(static_cast<LayoutPosition>(layer));
+	if (items == layerItems.end())
+	{
+		return out;
+	}
+	out.reserve(items->second.size());
+	for (auto item : items->second)
+	{
+		out.push_back(item.second);
+	}
+	return out;
+}
+
 bool Manager::CheckPositionFree(const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, string& result) const
 {
-	return CheckLayoutPositionFree(posX, posY, posZ, result, accessories, accessoryMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, tracks, trackMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, feedbacks, feedbackMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, switches, switchMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, routes, routeMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, signals, signalMutex);
+	const DataModel::LayoutItem* layout = GetLayoutItem(posX, posY, posZ);
+	if (layout == nullptr)
+	{
+		return true;
+	}
+	result.assign(Logger::Logger::Format(Languages::TextPositionAlreadyInUse, static_cast<int>(posX), static_cast<int>(posY), static_cast<int>(posZ), layout->GetLayoutType(), layout->GetName()));
+	return false;
 }
 
 bool Manager::CheckPositionFree(const LayoutPosition posX,
@@ -3056,20 +3339,67 @@ bool Manager::CheckPositionFree(const LayoutPosition posX,
 	return true;
 }
 
-template<class Type>
-bool Manager::CheckLayoutPositionFree(const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, string& result, const map<ObjectID, Type*>& layoutVector, std::mutex& mutex) const
+void Manager::LayoutIndexAdd(const DataModel::LayoutItem* item)
 {
-	std::lock_guard<std::mutex> guard(mutex);
-	for (auto layout : layoutVector)
+	// layoutMutex has to be locked by caller
+	if (item->GetVisible() == DataModel::LayoutItem::VisibleYes)
 	{
-		if (layout.second->CheckPositionFree(posX, posY, posZ))
+		layerItems[item->GetPosZ()][LayerKey(item)] = item;
+	}
+
+	LayoutPosition x;
+	LayoutPosition y;
+	LayoutPosition z;
+	LayoutItemSize w;
+	LayoutItemSize h;
+	LayoutRotation r;
+	if (item->GetVisible() == DataModel::LayoutItem::VisibleNo || item->Position(x, y, z, w, h, r) == false)
+	{
+		return;
+	}
+	for (LayoutPosition ix = x; ix < x + w; ++ix)
+	{
+		for (LayoutPosition iy = y; iy < y + h; ++iy)
 		{
-			continue;
+			layoutCells.emplace(CellKey(ix, iy, z), item);
+		}
+	}
+}
+
+void Manager::LayoutIndexRemove(const DataModel::LayoutItem* item)
+{
+	// layoutMutex has to be locked by caller
+	auto layer = layerItems.find(item->GetPosZ());
+	if (layer != layerItems.end())
+	{
+		layer->second.erase(LayerKey(item));
+	}
+
+	LayoutPosition x;
+	LayoutPosition y;
+	LayoutPosition z;
+	LayoutItemSize w;
+	LayoutItemSize h;
+	LayoutRotation r;
+	if (item->Position(x, y, z, w, h, r) == false)
+	{
+		return;
+	}
+	for (LayoutPosition ix = x; ix < x + w; ++ix)
+	{
+		for (LayoutPosition iy = y; iy < y + h; ++iy)
+		{
+			auto range = layoutCells.equal_range(CellKey(ix, iy, z));
+			for (auto entry = range.first; entry != range.second; ++entry)
+			{
+				if (entry->second == item)
+				{
+					layoutCells.erase(entry);
+					break;
+				}
+			}
 		}
-		result.assign(Logger::Logger::Format(Languages::GetText(Languages::TextPositionAlreadyInUse), static_cast<int>(posX), static_cast<int>(posY), static_cast<int>(posZ), layout.second->GetLayoutType(), layout.second->GetName()));
-		return false;
 	}
-	return true;
 }
 
 bool Manager::CheckAddressLoco(const Protocol protocol, const Address address, string& result)
@@ -3167,13 +3497,13 @@ bool Manager::CheckControlProtocolAddress(const AddressType type, const ControlI
 				}
 				protocolsText.append(ProtocolSymbols[p]);
 			}
-			result.assign(Logger::Logger::Format(Languages::GetText(Languages::TextProtocolNotSupported), protocolText, protocolsText));
+			result.assign(Logger::Logger::Format(Languages::TextProtocolNotSupported, protocolText, protocolsText));
 			return false;
 		}
 	}
 	if (address == 0)
 	{
-		result.assign(Logger::Logger::Format(Languages::GetText(Languages::TextAddressMustBeHigherThen0)));
+		result.assign(Logger::Logger::Format(Languages::TextAddressMustBeHigherThen0));
 		return false;
 	}
 	switch (type)
@@ -3224,16 +3554,32 @@ void Manager::DebounceWorker()
 {
 	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextDebouncer));
 	logger->Info(Languages::TextDebounceThreadStarted);
+	std::unique_lock<std::mutex> lock(debounceMutex);
 	while (debounceRun)
 	{
+		if (debounceQueue.empty())
+		{
+			debounceCondition.wait(lock);
+			continue;
+		}
+
+		const DebounceEntry entry = debounceQueue.top();
+		if (entry.first > std::chrono::steady_clock::now())
+		{
+			debounceCondition.wait_until(lock, entry.first);
+			continue;
+		}
+		debounceQueue.pop();
+		lock.unlock();
 		{
 			std::lock_guard<std::mutex> guard(feedbackMutex);
-			for (auto feedback : feedbacks)
+			Feedback* feedback = GetFeedbackUnlocked(entry.second);
+			if (feedback != nullptr)
 			{
-				feedback.second->Debounce();
+				feedback->Debounce(entry.first);
 			}
 		}
-		Utils::Utils::SleepForMilliseconds(250);
+		lock.lock();
 	}
 	logger->Info(Languages::TextDebounceThreadTerminated);
 }
@@ -3431,7 +3777,7 @@ bool Manager::ObjectIsPartOfRoute(const ObjectIdentifier& identifier,
 				selector = Languages::TextObjectIsUsedByRoute;
 				break;
 		}
-		result = Logger::Logger::Format(Languages::GetText(selector), object->GetName(), route.second->GetName());
+		result = Logger::Logger::Format(selector, object->GetName(), route.second->GetName());
 		return true;
 	}
 	return false;
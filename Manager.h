@@ -20,19 +20,25 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <queue>
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <unordered_map>
 #include <vector>
 
 #include "Config.h"
 #include "ControlInterface.h"
 #include "DataModel/DataModel.h"
 #include "Hardware/HardwareParams.h"
+#include "LocoScheduler.h"
 #include "Logger/Logger.h"
 #include "Storage/StorageHandler.h"
+#include "Timer.h"
 
 class Manager
 {
@@ -41,6 +47,12 @@ class Manager
 		Manager(Config& config);
 		~Manager();
 
+		// all objects are loaded and the controls may report their state
+		inline bool IsRunning() const
+		{
+			return run;
+		}
+
 		// booster
 		inline BoosterState Booster() const
 		{
@@ -66,6 +78,7 @@ class Manager
 
 		// control (console, web, ...)
 		const std::string GetControlName(const ControlID controlID);
+		bool ControlCommandStatistics(const ControlID controlID, unsigned int& sent, unsigned int& superseded, unsigned int& immediately);
 		const std::map<std::string,Hardware::HardwareParams*> ControlListByName() const;
 		const std::map<ControlID,std::string> LocoControlListNames() const;
 		const std::map<ControlID,std::string> AccessoryControlListNames() const;
@@ -87,6 +100,7 @@ class Manager
 
 		// loco
 		DataModel::Loco* GetLoco(const LocoID locoID) const;
+		DataModel::Loco* GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const;
 		const std::string& GetLocoName(const LocoID locoID) const;
 
 		inline const std::map<LocoID,DataModel::Loco*>& locoList() const
@@ -172,6 +186,7 @@ class Manager
 		void FeedbackState(const ControlID controlID, const FeedbackPin pin, const DataModel::Feedback::FeedbackState state);
 		void FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
 		void FeedbackPublishState(const DataModel::Feedback* feedback);
+		void FeedbackDebounce(const FeedbackID feedbackID, const DataModel::Feedback::DebounceDeadline deadline);
 		DataModel::Feedback* GetFeedback(const FeedbackID feedbackID) const;
 		DataModel::Feedback* GetFeedbackUnlocked(const FeedbackID feedbackID) const;
 		const std::string& GetFeedbackName(const FeedbackID feedbackID) const;
@@ -183,7 +198,8 @@ class Manager
 
 		const std::map<std::string,DataModel::Feedback*> FeedbackListByName() const;
 		const std::map<std::string,FeedbackID> FeedbacksOfTrack(const DataModel::ObjectIdentifier& identifier) const;
-		bool FeedbackSave(const FeedbackID feedbackID, const std::string& name, const DataModel::LayoutItem::Visible visible, const DataModel::LayoutItem::LayoutPosition posX, const DataModel::LayoutItem::LayoutPosition posY, const DataModel::LayoutItem::LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted,  std::string& result);
+		const std::vector<const DataModel::Feedback*> FeedbacksOfControl(const ControlID controlID) const;
+		bool FeedbackSave(const FeedbackID feedbackID, const std::string& name, const DataModel::LayoutItem::Visible visible, const DataModel::LayoutItem::LayoutPosition posX, const DataModel::LayoutItem::LayoutPosition posY, const DataModel::LayoutItem::LayoutPosition posZ, const ControlID controlID, const FeedbackPin pin, const bool inverted, const DataModel::Feedback::DebounceTime debounceTime, std::string& result);
 
 		bool FeedbackDelete(const FeedbackID feedbackID,
 			std::string& result);
@@ -307,6 +323,12 @@ class Manager
 		bool LayerDelete(const LayerID layerID,
 			std::string& result);
 
+		// all items visible on a layer in the order they are drawn
+		const std::vector<const DataModel::LayoutItem*> LayoutItemsOfLayer(const LayerID layer) const;
+		const DataModel::LayoutItem* GetLayoutItem(const DataModel::LayoutItem::LayoutPosition posX,
+			const DataModel::LayoutItem::LayoutPosition posY,
+			const DataModel::LayoutItem::LayoutPosition posZ) const;
+
 		// signal
 		bool SignalState(const ControlType controlType, const SignalID signalID, const DataModel::AccessoryState state, const bool force = false);
 		bool SignalState(const ControlType controlType, DataModel::Signal* signal, const DataModel::AccessoryState state, const bool force = false);
@@ -396,6 +418,16 @@ class Manager
 			return selectRouteApproach;
 		}
 
+		inline LocoScheduler& GetLocoScheduler()
+		{
+			return locoScheduler;
+		}
+
+		inline Timer& GetTimer()
+		{
+			return timer;
+		}
+
 		inline DataModel::Loco::NrOfTracksToReserve GetNrOfTracksToReserve() const
 		{
 			return nrOfTracksToReserve;
@@ -430,7 +462,6 @@ class Manager
 		bool ControlIsOfHardwareType(const ControlID controlID, const HardwareType hardwareType);
 
 		ControlInterface* GetControl(const ControlID controlID) const;
-		DataModel::Loco* GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const;
 		DataModel::Accessory* GetAccessory(const ControlID controlID, const Protocol protocol, const Address address) const;
 		DataModel::Switch* GetSwitch(const ControlID controlID, const Protocol protocol, const Address address) const;
 		DataModel::Feedback* GetFeedback(const ControlID controlID, const FeedbackPin pin) const;
@@ -462,12 +493,6 @@ class Manager
 			const DataModel::LayoutItem::LayoutRotation rotation,
 			std::string& result) const;
 
-		template<class Type>
-		bool CheckLayoutPositionFree(const DataModel::LayoutItem::LayoutPosition posX,
-			const DataModel::LayoutItem::LayoutPosition posY,
-			const DataModel::LayoutItem::LayoutPosition posZ,
-			std::string& result,
-			const std::map<ObjectID, Type*>& layoutVector, std::mutex& mutex) const;
 
 		bool CheckAccessoryPosition(const DataModel::Accessory* accessory,
 			const DataModel::LayoutItem::LayoutPosition posX,
@@ -507,6 +532,141 @@ class Manager
 			const DataModel::LayoutItem::LayoutPosition posZ,
 			std::string& result) const;
 
+		// hardware indices, used to find objects of events coming from a control without scanning all objects
+		typedef uint32_t HardwareIndexKey;
+		typedef uint64_t FeedbackIndexKey;
+
+		static inline HardwareIndexKey IndexKey(const ControlID controlID, const Protocol protocol, const Address address)
+		{
+			return (static_cast<HardwareIndexKey>(controlID) << 24) | (static_cast<HardwareIndexKey>(protocol) << 16) | address;
+		}
+
+		static inline HardwareIndexKey IndexKey(const DataModel::HardwareHandle* handle)
+		{
+			return IndexKey(handle->GetControlID(), handle->GetProtocol(), handle->GetAddress());
+		}
+
+		static inline FeedbackIndexKey IndexKey(const ControlID controlID, const FeedbackPin pin)
+		{
+			return (static_cast<FeedbackIndexKey>(controlID) << 32) | pin;
+		}
+
+		static inline FeedbackIndexKey IndexKey(const DataModel::Feedback* feedback)
+		{
+			return IndexKey(feedback->GetControlID(), feedback->GetPin());
+		}
+
+		// if more than one object has the same key the one with the lowest ID is found, like a linear search would do
+		template<class Key, class T>
+		static void IndexAdd(std::unordered_map<Key,T*>& index, const Key key, T* object)
+		{
+			auto entry = index.find(key);
+			if (entry != index.end() && entry->second->GetID() < object->GetID())
+			{
+				return;
+			}
+			index[key] = object;
+		}
+
+		template<class Key, class ID, class T>
+		static void IndexRemove(std::unordered_map<Key,T*>& index, const std::map<ID,T*>& objects, const Key key, const T* object)
+		{
+			auto entry = index.find(key);
+			if (entry == index.end() || entry->second != object)
+			{
+				return;
+			}
+			index.erase(entry);
+			for (auto other : objects)
+			{
+				if (other.second == object || IndexKey(other.second) != key)
+				{
+					continue;
+				}
+				index[key] = other.second;
+				return;
+			}
+		}
+
+		template<class Key, class ID, class T>
+		static void IndexUpdate(std::unordered_map<Key,T*>& index, const std::map<ID,T*>& objects, const Key oldKey, T* object)
+		{
+			const Key newKey = IndexKey(object);
+			if (oldKey == newKey && index.count(oldKey) == 1)
+			{
+				return;
+			}
+			IndexRemove(index, objects, oldKey, object);
+			IndexAdd(index, newKey, object);
+		}
+
+		template<class Key, class ID, class T>
+		static void IndexBuild(std::unordered_map<Key,T*>& index, const std::map<ID,T*>& objects)
+		{
+			index.clear();
+			for (auto object : objects)
+			{
+				IndexAdd(index, IndexKey(object.second), object.second);
+			}
+		}
+
+		// layout occupancy, every cell covered by a visible layout item is mapped to the item
+		typedef uint32_t LayoutCellKey;
+
+		static inline LayoutCellKey CellKey(const DataModel::LayoutItem::LayoutPosition posX,
+			const DataModel::LayoutItem::LayoutPosition posY,
+			const DataModel::LayoutItem::LayoutPosition posZ)
+		{
+			return (static_cast<LayoutCellKey>(static_cast<unsigned char>(posZ)) << 16)
+				| (static_cast<LayoutCellKey>(static_cast<unsigned char>(posY)) << 8)
+				| static_cast<unsigned char>(posX);
+		}
+
+		// items of a layer are sorted by type in drawing order and then by ID
+		typedef std::pair<unsigned char,ObjectID> LayerItemKey;
+
+		static inline LayerItemKey LayerKey(const DataModel::LayoutItem* item)
+		{
+			return LayerItemKey(LayerDrawingOrder(item->GetObjectType()), item->GetID());
+		}
+
+		static inline unsigned char LayerDrawingOrder(const ObjectType type)
+		{
+			switch (type)
+			{
+				case ObjectTypeAccessory:
+					return 0;
+
+				case ObjectTypeSwitch:
+					return 1;
+
+				case ObjectTypeTrack:
+					return 2;
+
+				case ObjectTypeRoute:
+					return 3;
+
+				case ObjectTypeFeedback:
+					return 4;
+
+				default:
+					return 5;
+			}
+		}
+
+		void LayoutIndexAdd(const DataModel::LayoutItem* item);
+		void LayoutIndexRemove(const DataModel::LayoutItem* item);
+
+		template<class ID, class T>
+		void LayoutIndexBuild(const std::map<ID,T*>& objects)
+		{
+			std::lock_guard<std::mutex> guard(layoutMutex);
+			for (auto object : objects)
+			{
+				LayoutIndexAdd(object.second);
+			}
+		}
+
 		bool CheckAddressLoco(const Protocol protocol, const Address address, std::string& result);
 		bool CheckAddressAccessory(const Protocol protocol, const Address address, std::string& result);
 
@@ -617,12 +777,11 @@ class Manager
 
 		bool LocoIntoTrackBase(Logger::Logger *logger, DataModel::Loco* loco, const ObjectType objectType, DataModel::TrackBase* track);
 
+		// sends the state of all locos to their controls in the background
+		void StartInitLocos();
 		void InitLocos();
-
-		static inline void InitLocosStatic(Manager* manager)
-		{
-			manager->InitLocos();
-		}
+		void SendLocoStates();
+		void LocoStatesSent(const unsigned int sent, const unsigned int total);
 
 		void ProgramCheckBooster(const ProgramMode mode);
 
@@ -645,14 +804,18 @@ class Manager
 
 		// loco
 		std::map<LocoID,DataModel::Loco*> locos;
+		std::unordered_map<HardwareIndexKey,DataModel::Loco*> locosByHardware;
 		mutable std::mutex locoMutex;
 
 		// accessory
 		std::map<AccessoryID,DataModel::Accessory*> accessories;
+		std::unordered_map<HardwareIndexKey,DataModel::Accessory*> accessoriesByHardware;
 		mutable std::mutex accessoryMutex;
 
 		// feedback
 		std::map<FeedbackID,DataModel::Feedback*> feedbacks;
+		std::unordered_map<FeedbackIndexKey,DataModel::Feedback*> feedbacksByHardware;
+		std::map<ControlID,std::map<FeedbackID,const DataModel::Feedback*>> feedbacksByControl;
 		mutable std::mutex feedbackMutex;
 
 		// track
@@ -661,6 +824,7 @@ class Manager
 
 		// switch
 		std::map<SwitchID,DataModel::Switch*> switches;
+		std::unordered_map<HardwareIndexKey,DataModel::Switch*> switchesByHardware;
 		mutable std::mutex switchMutex;
 
 		// route
@@ -673,12 +837,18 @@ class Manager
 
 		// signal
 		std::map<SignalID,DataModel::Signal*> signals;
+		std::unordered_map<HardwareIndexKey,DataModel::Signal*> signalsByHardware;
 		mutable std::mutex signalMutex;
 
 		// cluster
 		std::map<SignalID,DataModel::Cluster*> clusters;
 		mutable std::mutex clusterMutex;
 
+		// layout
+		std::unordered_multimap<LayoutCellKey,const DataModel::LayoutItem*> layoutCells;
+		std::map<DataModel::LayoutItem::LayoutPosition,std::map<LayerItemKey,const DataModel::LayoutItem*>> layerItems;
+		mutable std::mutex layoutMutex;
+
 		// storage
 		Storage::StorageHandler* storage;
 
@@ -689,10 +859,22 @@ class Manager
 		DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve;
 
 		volatile bool run;
+		// feedbacks waiting to be free, ordered by their deadline
+		typedef std::pair<DataModel::Feedback::DebounceDeadline,FeedbackID> DebounceEntry;
+		std::priority_queue<DebounceEntry,std::vector<DebounceEntry>,std::greater<DebounceEntry>> debounceQueue;
+		std::mutex debounceMutex;
+		std::condition_variable debounceCondition;
 		volatile bool debounceRun;
 		std::thread debounceThread;
 
 		volatile bool initLocosDone;
+		std::mutex initLocosMutex;
+		bool initLocosRunning;
+		bool initLocosAgain;
+		std::thread initLocosThread;
+
+		LocoScheduler locoScheduler;
+		Timer timer;
 
 		const std::string unknownControl;
 		const std::string unknownLoco;
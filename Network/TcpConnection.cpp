@@ -19,6 +19,10 @@ along with RailControl; see the file LICENCE. If not see
 */
 
 #include <arpa/inet.h>
+#include <cstring>		//memset
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>   // close & TEMP_FAILURE_RETRY;
 
 #include "Network/Select.h"
@@ -27,13 +31,39 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Network
 {
+	TcpConnection::~TcpConnection()
+	{
+		Terminate();
+		if (connectionSocket > 0)
+		{
+			close(connectionSocket);
+		}
+	}
+
 	void TcpConnection::Terminate()
 	{
 		if (connected)
 		{
 			connected = false;
-			close(connectionSocket);
+			shutdown(connectionSocket, SHUT_RDWR);
+		}
+	}
+
+	int TcpConnection::Wait(const short events, const int timeout)
+	{
+		errno = 0;
+		struct pollfd fd;
+		fd.fd = connectionSocket;
+		fd.events = events;
+		fd.revents = 0;
+
+		int ret = TEMP_FAILURE_RETRY(poll(&fd, 1, timeout));
+		if (ret == 0)
+		{
+			errno = ETIMEDOUT;
+			return -1;
 		}
+		return ret;
 	}
 
 	int TcpConnection::Send(const char* buffer, const size_t bufferLength, const int flags)
@@ -43,25 +73,21 @@ namespace Network
 			errno = ENOTCONN;
 			return -1;
 		}
-		errno = 0;
-		fd_set set;
-		FD_ZERO(&set);
-		FD_SET(connectionSocket, &set);
-		struct timeval timeout;
-		timeout.tv_sec = 5;
-		timeout.tv_usec = 0;
-
-		int ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, NULL, &set, NULL, &timeout));
-		if (ret < 0)
+
+		int ret;
+		if ((flags & MSG_DONTWAIT) == 0)
 		{
-			return ret;
+			ret = Wait(POLLOUT, 5000);
+			if (ret < 0)
+			{
+				return ret;
+			}
 		}
-		if (ret == 0)
+		ret = send(connectionSocket, buffer, bufferLength, flags | MSG_NOSIGNAL);
+		if (ret < 0 && (flags & MSG_DONTWAIT) && (errno == EAGAIN || errno == EWOULDBLOCK))
 		{
-			errno = ETIMEDOUT;
-			return -1;
+			return 0;
 		}
-		ret = send(connectionSocket, buffer, bufferLength, flags | MSG_NOSIGNAL);
 		if (ret <= 0)
 		{
 			errno = ECONNRESET;
@@ -71,31 +97,73 @@ namespace Network
 		return ret;
 	}
 
-	int TcpConnection::Receive(char* buf, const size_t buflen, const int flags)
+	int TcpConnection::Send(const std::string& header, const std::string& body)
 	{
 		if (connectionSocket == 0 || connected == false)
 		{
 			errno = ENOTCONN;
 			return -1;
 		}
-		errno = 0;
-		fd_set set;
-		FD_ZERO(&set);
-		FD_SET(connectionSocket, &set);
-		struct timeval timeout;
-		timeout.tv_sec = 1;
-		timeout.tv_usec = 0;
-
-		int ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, &set, NULL, NULL, &timeout));
-		if (ret < 0)
+
+		struct iovec buffers[2];
+		buffers[0].iov_base = const_cast<char*>(header.c_str());
+		buffers[0].iov_len = header.size();
+		buffers[1].iov_base = const_cast<char*>(body.c_str());
+		buffers[1].iov_len = body.size();
+
+		struct msghdr message;
+		memset(&message, 0, sizeof(message));
+		message.msg_iov = buffers;
+		message.msg_iovlen = 2;
+
+		const size_t total = header.size() + body.size();
+		size_t sent = 0;
+		while (sent < total)
 		{
-			return ret;
+			int ret = Wait(POLLOUT, 5000);
+			if (ret < 0)
+			{
+				return ret;
+			}
+			ret = sendmsg(connectionSocket, &message, MSG_NOSIGNAL);
+			if (ret <= 0)
+			{
+				errno = ECONNRESET;
+				Terminate();
+				return -1;
+			}
+			sent += ret;
+
+			// skip what has already been sent if the kernel accepted only a part
+			size_t skip = ret;
+			while (message.msg_iovlen > 0 && skip >= message.msg_iov[0].iov_len)
+			{
+				skip -= message.msg_iov[0].iov_len;
+				++message.msg_iov;
+				--message.msg_iovlen;
+			}
+			if (message.msg_iovlen > 0)
+			{
+				message.msg_iov[0].iov_base = static_cast<char*>(message.msg_iov[0].iov_base) + skip;
+				message.msg_iov[0].iov_len -= skip;
+			}
 		}
-		if (ret == 0)
+		return sent;
+	}
+
+	int TcpConnection::Receive(char* buf, const size_t buflen, const int flags)
+	{
+		if (connectionSocket == 0 || connected == false)
 		{
-			errno = ETIMEDOUT;
+			errno = ENOTCONN;
 			return -1;
 		}
+
+		int ret = Wait(POLLIN, 1000);
+		if (ret < 0)
+		{
+			return ret;
+		}
 		ret = recv(connectionSocket, buf, buflen, flags);
 		if (ret <= 0)
 		{
@@ -33,25 +33,34 @@ namespace Network
 				connected(socket != 0)
 			{}
 
-			~TcpConnection()
-			{
-				Terminate();
-			}
+			~TcpConnection();
 
+			// shuts the connection down, the socket is closed by the destructor,
+			// so its number can not be reused while another thread still polls it
 			void Terminate();
+
+			// with MSG_DONTWAIT in flags send does not wait for the socket to become writable
+			// and returns 0 if the socket can not take any data
 			int Send(const char* buffer, const size_t bufferLength, const int flags = 0);
 			int Send(const unsigned char* buffer, const size_t bufferLength, const int flags = 0) { return Send(reinterpret_cast<const char*>(buffer), bufferLength, flags); }
 			int Send(const std::string& string, const int flags = 0)
 			{
 				return Send(string.c_str(), string.size(), flags);
 			}
+			// sends header and body with one single system call without copying them together
+			int Send(const std::string& header, const std::string& body);
 
 			int Receive(char* buf, const size_t buflen, const int flags = 0);
 			int Receive(unsigned char* buffer, const size_t bufferLength, const int flags = 0) { return Receive(reinterpret_cast<char*>(buffer), bufferLength, flags); }
 
 			bool IsConnected() const { return connected; }
 
+			int GetSocket() const { return connectionSocket; }
+
 		private:
+			// waits with poll for events on the socket, timeout in milliseconds
+			int Wait(const short events, const int timeout);
+
 			int connectionSocket;
 			volatile bool connected;
 	};
@@ -20,8 +20,10 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <cstring>		//memset
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -38,6 +40,8 @@ namespace Network
 	 	error(""),
 	 	threadName(threadName)
 	{
+		wakeupPipe[0] = -1;
+		wakeupPipe[1] = -1;
 		struct sockaddr_in6 serverAddr6;
 		memset(reinterpret_cast<char*>(&serverAddr6), 0, sizeof(serverAddr6));
 		serverAddr6.sin6_family = AF_INET6;
@@ -53,18 +57,33 @@ namespace Network
 		serverAddr4.sin_port = htons(port);
 		SocketCreateBindListen(serverAddr4.sin_family, reinterpret_cast<struct sockaddr*>(&serverAddr4));
 #endif
+
+		if (serverSockets.size() == 0)
+		{
+			return;
+		}
+
+		int intResult = pipe(wakeupPipe);
+		if (intResult < 0)
+		{
+			wakeupPipe[0] = -1;
+			wakeupPipe[1] = -1;
+			error = "Unable to create wakeup pipe for tcp server. Unable to serve clients.";
+			for (int serverSocket : serverSockets)
+			{
+				close(serverSocket);
+			}
+			serverSockets.clear();
+			return;
+		}
+		// a wakeup must neither block the caller nor the event loop when draining the pipe
+		fcntl(wakeupPipe[0], F_SETFL, O_NONBLOCK);
+		fcntl(wakeupPipe[1], F_SETFL, O_NONBLOCK);
 	}
 
 	TcpServer::~TcpServer()
 	{
 		TerminateTcpServer();
-
-		while (connections.size())
-		{
-			TcpConnection* client = connections.back();
-			connections.pop_back();
-			delete client;
-		}
 	}
 
 	void TcpServer::SocketCreateBindListen(int family, struct sockaddr* address)
@@ -93,8 +112,7 @@ namespace Network
 			return;
 		}
 
-		const int MaxClientsInQueue = 5;
-		intResult = listen(serverSocket, MaxClientsInQueue);
+		intResult = listen(serverSocket, SOMAXCONN);
 		if (intResult != 0)
 		{
 			error = "Unable to listen on socket for tcp server. Unable to serve clients.";
@@ -102,66 +120,218 @@ namespace Network
 			return;
 		}
 
+		serverSockets.push_back(serverSocket);
+	}
+
+	void TcpServer::StartTcpServer(const unsigned int workers)
+	{
+		if (run == true || serverSockets.size() == 0)
+		{
+			return;
+		}
+
 		run = true;
-		serverThreads.push_back(std::thread(&Network::TcpServer::Worker, this, serverSocket));
+		serverThread = std::thread(&Network::TcpServer::EventLoop, this);
+		for (unsigned int worker = 0; worker < (workers > 0 ? workers : 1); ++worker)
+		{
+			workerThreads.push_back(std::thread(&Network::TcpServer::Worker, this));
+		}
 	}
 
 	void TcpServer::TerminateTcpServer()
 	{
-		if (run == false)
+		if (run == true)
 		{
-			return;
+			Stop();
 		}
 
-		run = false;
+		for (int serverSocket : serverSockets)
+		{
+			close(serverSocket);
+		}
+		serverSockets.clear();
+		if (wakeupPipe[0] >= 0)
+		{
+			close(wakeupPipe[0]);
+			close(wakeupPipe[1]);
+			wakeupPipe[0] = -1;
+			wakeupPipe[1] = -1;
+		}
+	}
 
-		for(std::thread& serverThread : serverThreads)
+	void TcpServer::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> guard(connectionsMutex);
+			run = false;
+		}
+		Wakeup();
+		serverThread.join();
+		readyCondition.notify_all();
+		for (auto& workerThread : workerThreads)
 		{
-			serverThread.join();
+			workerThread.join();
 		}
+		workerThreads.clear();
+
+		// no thread of the server is running anymore, so the connections can be closed without locking
+		for (auto connection : connections)
+		{
+			Disconnected(connection);
+			delete connection;
+		}
+		connections.clear();
+		idleConnections.clear();
+		readyConnections.clear();
+	}
+
+	void TcpServer::Wakeup()
+	{
+		const char wakeup = 0;
+		__attribute__((unused)) ssize_t written = write(wakeupPipe[1], &wakeup, sizeof(wakeup));
 	}
 
-	void TcpServer::Worker(int socket)
+	void TcpServer::EventLoop()
 	{
 		Utils::Utils::SetThreadName(threadName);
-		fd_set set;
-		struct timeval tv;
+
+		std::vector<struct pollfd> fds;
+		std::vector<TcpConnection*> polledConnections;
 		struct sockaddr_in6 client_addr;
-		socklen_t client_addr_len = sizeof(client_addr);
 		while (run == true)
 		{
-			// wait for connection and abort on shutdown
-			int ret;
-			do
+			// first entry is the wakeup pipe, followed by all listening sockets and all idle connections
+			fds.resize(serverSockets.size() + 1);
+			fds[0].fd = wakeupPipe[0];
+			fds[0].events = POLLIN;
+			for (size_t i = 0; i < serverSockets.size(); ++i)
 			{
-				FD_ZERO(&set);
-				FD_SET(socket, &set);
-				tv.tv_sec = 1;
-				tv.tv_usec = 0;
-				ret = TEMP_FAILURE_RETRY(select(FD_SETSIZE, &set, NULL, NULL, &tv));
+				fds[i + 1].fd = serverSockets[i];
+				fds[i + 1].events = POLLIN;
+			}
+			{
+				std::lock_guard<std::mutex> guard(connectionsMutex);
+				polledConnections.assign(idleConnections.begin(), idleConnections.end());
+			}
+			for (auto connection : polledConnections)
+			{
+				struct pollfd fd;
+				fd.fd = connection->GetSocket();
+				fd.events = POLLIN;
+				fds.push_back(fd);
+			}
+			for (auto& fd : fds)
+			{
+				fd.revents = 0;
+			}
+
+			// wait for connection, data, hangup or wakeup without timeout
+			int ret = TEMP_FAILURE_RETRY(poll(fds.data(), fds.size(), -1));
+			if (run == false)
+			{
+				return;
+			}
+
+			if (ret <= 0)
+			{
+				continue;
+			}
 
-				if (run == false)
+			if (fds[0].revents & POLLIN)
+			{
+				char wakeup[16];
+				while (read(wakeupPipe[0], wakeup, sizeof(wakeup)) > 0)
 				{
-					return;
 				}
-			} while (ret == 0);
+			}
 
-			if (ret < 0)
+			for (size_t i = 1; i <= serverSockets.size(); ++i)
 			{
-				continue;
+				if ((fds[i].revents & POLLIN) == 0)
+				{
+					continue;
+				}
+
+				// accept connection
+				socklen_t client_addr_len = sizeof(client_addr);
+				int socketClient = accept(fds[i].fd, reinterpret_cast<struct sockaddr*>(&client_addr), &client_addr_len);
+				if (socketClient < 0)
+				{
+					continue;
+				}
+
+				TcpConnection* connection = new TcpConnection(socketClient);
+				if (Connected(connection) == false)
+				{
+					delete connection;
+					continue;
+				}
+				std::lock_guard<std::mutex> guard(connectionsMutex);
+				connections.insert(connection);
+				idleConnections.insert(connection);
 			}
 
-			// accept connection
-			int socketClient = accept(socket, reinterpret_cast<struct sockaddr*>(&client_addr), &client_addr_len);
-			if (socketClient < 0)
+			const size_t firstConnection = serverSockets.size() + 1;
+			bool ready = false;
+			{
+				std::lock_guard<std::mutex> guard(connectionsMutex);
+				for (size_t i = 0; i < polledConnections.size(); ++i)
+				{
+					if (fds[firstConnection + i].revents == 0)
+					{
+						continue;
+					}
+					// POLLHUP and POLLERR are handed to the worker too, its receive notices the closed connection
+					TcpConnection* connection = polledConnections[i];
+					idleConnections.erase(connection);
+					readyConnections.push_back(connection);
+					ready = true;
+				}
+			}
+			if (ready)
 			{
+				readyCondition.notify_all();
+			}
+		}
+	}
+
+	void TcpServer::Worker()
+	{
+		Utils::Utils::SetThreadName(threadName);
+		std::unique_lock<std::mutex> lock(connectionsMutex);
+		while (true)
+		{
+			readyCondition.wait(lock, [&] { return run == false || readyConnections.empty() == false; });
+			if (run == false)
+			{
+				return;
+			}
+			TcpConnection* connection = readyConnections.front();
+			readyConnections.pop_front();
+			lock.unlock();
+
+			const bool keep = Work(connection);
+			if (keep == false)
+			{
+				Close(connection);
+				lock.lock();
 				continue;
 			}
 
-			// create client and fill into vector
-			auto con = new TcpConnection(socketClient);
-			connections.push_back(con);
-			Work(con);
+			lock.lock();
+			idleConnections.insert(connection);
+			// the event loop has to poll the connection again
+			Wakeup();
+		}
+	}
+
+	void TcpServer::Close(TcpConnection* connection)
+	{
+		{
+			std::lock_guard<std::mutex> guard(connectionsMutex);
+			connections.erase(connection);
 		}
+		Disconnected(connection);
+		delete connection;
 	}
 }
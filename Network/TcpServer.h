@@ -20,6 +20,10 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -30,6 +34,9 @@ struct sockaddr;
 
 namespace Network
 {
+	// one event loop thread polls the listening sockets and all idle connections,
+	// a connection with pending data is handed to one of a few worker threads,
+	// so the number of threads does not grow with the number of connected clients
 	class TcpServer
 	{
 		public:
@@ -38,18 +45,48 @@ namespace Network
 		protected:
 			TcpServer(const unsigned short port, const std::string& threadName);
 			virtual ~TcpServer();
+
+			// has to be called at the end of the constructor of the implementation, the callbacks below are called from now on
+			void StartTcpServer(const unsigned int workers);
+
+			// has to be called in the destructor of the implementation, the callbacks below are called until it returns
 			void TerminateTcpServer();
 
-			virtual void Work(Network::TcpConnection* connection) = 0;
+			// called by the event loop for a new connection, returning false closes the connection
+			virtual bool Connected(Network::TcpConnection* connection) = 0;
+
+			// called by a worker thread when data or a hangup is pending on connection,
+			// returning false closes the connection
+			// a connection is never handed to two workers at the same time
+			virtual bool Work(Network::TcpConnection* connection) = 0;
+
+			// called before a connection is deleted, the implementation must not use it afterwards
+			virtual void Disconnected(Network::TcpConnection* connection) = 0;
 
 		private:
 			void SocketCreateBindListen(int family, struct sockaddr* address);
-			void Worker(int socket);
+			void Stop();
+			void EventLoop();
+			void Worker();
+			void Wakeup();
+			void Close(Network::TcpConnection* connection);
 
 			volatile bool run;
-			std::vector<std::thread> serverThreads;
-			std::vector<TcpConnection*> connections;
+			std::thread serverThread;
+			std::vector<std::thread> workerThreads;
+			std::vector<int> serverSockets;
+			// writing to wakeupPipe[1] interrupts the poll of the event loop
+			int wakeupPipe[2];
 			std::string error;
 			const std::string threadName;
+
+			// the connections are owned by the server, each one is either idle or ready or worked on
+			std::set<Network::TcpConnection*> connections;
+			// polled by the event loop
+			std::set<Network::TcpConnection*> idleConnections;
+			// waiting for a worker
+			std::deque<Network::TcpConnection*> readyConnections;
+			std::mutex connectionsMutex;
+			std::condition_variable readyCondition;
 	};
 }
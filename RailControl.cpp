@@ -44,17 +44,18 @@ static volatile unsigned int runRailcontrol;
 
 static volatile unsigned char stopSignalCounter;
 static const unsigned char maxStopSignalCounter = 3;
+static volatile int stopSignal;
 
+// the signal may interrupt a thread that is just logging,
+// so the handler only records the signal and the main loop logs it
 void stopRailControlSignal(int signo)
 {
-	Logger::Logger* logger = Logger::Logger::GetLogger("Main");
-	logger->Info(Languages::TextStoppingRequestedBySignal, signo);
+	stopSignal = signo;
 	runRailcontrol = false;
 	if (++stopSignalCounter < maxStopSignalCounter)
 	{
 		return;
 	}
-	logger->Info(Languages::TextReceivedSignalKill, maxStopSignalCounter);
 	exit(1);
 }
 
@@ -101,6 +102,7 @@ int main (int argc, char* argv[])
 	}
 
 	stopSignalCounter = 0;
+	stopSignal = 0;
 	signal(SIGINT, stopRailControlSignal);
 	signal(SIGTERM, stopRailControlSignal);
 
@@ -156,6 +158,10 @@ int main (int argc, char* argv[])
 		}
 	} while (input != 'q' && runRailcontrol);
 
+	if (stopSignal != 0)
+	{
+		logger->Info(Languages::TextStoppingRequestedBySignal, stopSignal);
+	}
 	logger->Info(Languages::TextStoppingRailControl);
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,153 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Timer.h"
+#include "Utils/Utils.h"
+
+Timer::Timer()
+:	run(true)
+{
+	timerThread = std::thread(&Timer::Worker, this);
+}
+
+Timer::~Timer()
+{
+	Terminate();
+}
+
+void Timer::Schedule(const void* owner, const Key key, const Deadline deadline, const Action& action)
+{
+	std::vector<Action> actions;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		ExtractUnlocked(owner, &key, actions);
+		if (run)
+		{
+			queue.emplace(deadline, Entry(owner, key, action));
+		}
+		else
+		{
+			actions.push_back(action);
+		}
+	}
+	queueCondition.notify_one();
+	RunActions(actions);
+}
+
+void Timer::RunPending(const void* owner, const Key key)
+{
+	std::vector<Action> actions;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		ExtractUnlocked(owner, &key, actions);
+	}
+	RunActions(actions);
+}
+
+void Timer::RunPending(const void* owner)
+{
+	std::vector<Action> actions;
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		ExtractUnlocked(owner, nullptr, actions);
+	}
+	// even with no pending action, an action of owner may still be running
+	std::lock_guard<std::mutex> guard(actionMutex);
+	for (const Action& action : actions)
+	{
+		action();
+	}
+}
+
+void Timer::Terminate()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+	}
+	queueCondition.notify_all();
+	if (timerThread.joinable())
+	{
+		timerThread.join();
+	}
+}
+
+void Timer::ExtractUnlocked(const void* owner, const Key* key, std::vector<Action>& actions)
+{
+	for (auto entry = queue.begin(); entry != queue.end(); )
+	{
+		if (entry->second.owner != owner || (key != nullptr && entry->second.key != *key))
+		{
+			++entry;
+			continue;
+		}
+		actions.push_back(entry->second.action);
+		entry = queue.erase(entry);
+	}
+}
+
+void Timer::RunActions(const std::vector<Action>& actions)
+{
+	if (actions.empty())
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> guard(actionMutex);
+	for (const Action& action : actions)
+	{
+		action();
+	}
+}
+
+void Timer::Worker()
+{
+	Utils::Utils::SetThreadName("Timer");
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		if (queue.empty())
+		{
+			if (!run)
+			{
+				return;
+			}
+			queueCondition.wait(lock);
+			continue;
+		}
+
+		auto entry = queue.begin();
+		// on termination the pending actions are run without waiting for their deadline
+		if (run && entry->first > std::chrono::steady_clock::now())
+		{
+			queueCondition.wait_until(lock, entry->first);
+			continue;
+		}
+
+		Action action = entry->second.action;
+		queue.erase(entry);
+		{
+			// actionMutex is taken before mutex is released, so RunPending can not overtake this action
+			std::lock_guard<std::mutex> guard(actionMutex);
+			lock.unlock();
+			action();
+		}
+		lock.lock();
+	}
+}
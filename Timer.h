@@ -0,0 +1,93 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// runs short actions like switching off an accessory at a given time on one shared thread
+// every action belongs to an owner and has a key, an owner can have only one pending action per key
+// actions must not use the timer themselves
+class Timer
+{
+	public:
+		typedef std::chrono::steady_clock::time_point Deadline;
+		typedef std::function<void()> Action;
+		typedef uint64_t Key;
+
+		Timer(const Timer&) = delete;
+		Timer& operator=(const Timer&) = delete;
+
+		Timer();
+		~Timer();
+
+		// a pending action of owner with the same key is run immediately before
+		void Schedule(const void* owner, const Key key, const Deadline deadline, const Action& action);
+
+		inline void Schedule(const void* owner, const Key key, const std::chrono::milliseconds delay, const Action& action)
+		{
+			Schedule(owner, key, std::chrono::steady_clock::now() + delay, action);
+		}
+
+		// runs the pending action of owner with key immediately
+		void RunPending(const void* owner, const Key key);
+
+		// runs all pending actions of owner immediately, must be called before owner is destroyed
+		void RunPending(const void* owner);
+
+		// runs all pending actions immediately and stops the timer thread
+		void Terminate();
+
+	private:
+		struct Entry
+		{
+			Entry(const void* owner, const Key key, const Action& action)
+			:	owner(owner),
+				key(key),
+				action(action)
+			{}
+
+			const void* owner;
+			Key key;
+			Action action;
+		};
+
+		typedef std::multimap<Deadline,Entry> Queue;
+
+		void Worker();
+		// mutex has to be locked by caller, the extracted actions have to be run with RunActions
+		void ExtractUnlocked(const void* owner, const Key* key, std::vector<Action>& actions);
+		void RunActions(const std::vector<Action>& actions);
+
+		Queue queue;
+		std::mutex mutex;
+		// held while an action is run so that actions of the same key never overtake each other
+		std::mutex actionMutex;
+		std::condition_variable queueCondition;
+		volatile bool run;
+		std::thread timerThread;
+};
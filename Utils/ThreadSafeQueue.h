@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <queue>
 #include <mutex>
@@ -68,6 +69,26 @@ namespace Utils
 				return val;
 			}
 
+			// returns false if no entry has been enqueued until deadline
+			bool DequeueUntil(T& val, const std::chrono::steady_clock::time_point deadline)
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				while (queue.empty())
+				{
+					if (run == false || cv.wait_until(lock, deadline) == std::cv_status::timeout)
+					{
+						if (queue.empty())
+						{
+							return false;
+						}
+						break;
+					}
+				}
+				val = queue.front();
+				queue.pop();
+				return true;
+			}
+
 			bool IsEmpty()
 			{
 				std::unique_lock<std::mutex> lock(mutex);
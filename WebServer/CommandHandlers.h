@@ -0,0 +1,37 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace WebServer
+{
+	class HttpRequest;
+	class WebClient;
+
+	// handles one request with cmd=<name>, gets the arguments and the complete request
+	typedef void (*CommandHandler)(WebClient& client, const std::map<std::string,std::string>& arguments, const HttpRequest& request);
+
+	// maps the value of the cmd argument to its handler
+	typedef std::unordered_map<std::string,CommandHandler> CommandHandlers;
+} // namespace WebServer
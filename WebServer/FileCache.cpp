@@ -0,0 +1,231 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "Hardware/ZLib.h"
+#include "Languages.h"
+#include "Utils/Utils.h"
+#include "WebServer/FileCache.h"
+
+using std::map;
+using std::shared_ptr;
+using std::string;
+
+namespace WebServer
+{
+	FileCache::FileCache(const string& directory, const bool watch)
+	:	directory(directory),
+		logger(Logger::Logger::GetLogger("Webserver")),
+		run(false)
+	{
+		Load();
+#ifdef __linux__
+		if (watch == false)
+		{
+			return;
+		}
+		run = true;
+		watcherThread = std::thread(&FileCache::Watcher, this);
+#else
+		(void) watch;
+#endif
+	}
+
+	FileCache::~FileCache()
+	{
+		if (run == false)
+		{
+			return;
+		}
+		run = false;
+		watcherThread.join();
+	}
+
+	shared_ptr<const FileCache::File> FileCache::Get(const string& name)
+	{
+		std::lock_guard<std::mutex> guard(filesMutex);
+		auto file = files.find(name);
+		if (file == files.end())
+		{
+			return nullptr;
+		}
+		return file->second;
+	}
+
+	string FileCache::Version()
+	{
+		std::lock_guard<std::mutex> guard(filesMutex);
+		return version;
+	}
+
+	void FileCache::Load()
+	{
+		DIR* dir = opendir(directory.c_str());
+		if (dir == nullptr)
+		{
+			logger->Error(Languages::TextCanNotOpenDirectory, directory);
+			return;
+		}
+
+		map<string,shared_ptr<const File>> newFiles;
+		string allEtags;
+		struct dirent* entry;
+		while ((entry = readdir(dir)) != nullptr)
+		{
+			const string name(entry->d_name);
+			const string path = directory + "/" + name;
+			struct stat s;
+			if (stat(path.c_str(), &s) != 0 || S_ISREG(s.st_mode) == false)
+			{
+				continue;
+			}
+
+			std::ifstream source(path, std::ios::binary);
+			if (source.is_open() == false)
+			{
+				continue;
+			}
+			std::stringstream buffer;
+			buffer << source.rdbuf();
+
+			File* file = new File();
+			file->contentType = ContentType(name);
+			file->content = buffer.str();
+			// strong etag, has to change with every change of the content
+			file->etag = "\"" + Utils::Utils::IntegerToHex(ZLib::Crc32(file->content), 8) + "-" + std::to_string(file->content.size()) + "\"";
+			if (IsCompressible(file->contentType))
+			{
+				string compressed = ZLib::CompressGzip(file->content);
+				if (compressed.size() > 0 && compressed.size() < file->content.size())
+				{
+					file->contentGzip = std::move(compressed);
+					file->etagGzip = file->etag.substr(0, file->etag.size() - 1) + "-gzip\"";
+				}
+			}
+			allEtags += file->etag;
+			newFiles["/" + name] = shared_ptr<const File>(file);
+		}
+		closedir(dir);
+
+		const size_t count = newFiles.size();
+		{
+			std::lock_guard<std::mutex> guard(filesMutex);
+			files.swap(newFiles);
+			version = Utils::Utils::IntegerToHex(ZLib::Crc32(allEtags), 8);
+		}
+		logger->Info(Languages::TextWebServerFilesCached, count, directory);
+	}
+
+#ifdef __linux__
+	void FileCache::Watcher()
+	{
+		Utils::Utils::SetThreadName("WebServer Files");
+		int fd = inotify_init();
+		if (fd < 0)
+		{
+			return;
+		}
+		if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO) < 0)
+		{
+			close(fd);
+			return;
+		}
+
+		char buffer[4096];
+		struct pollfd watch;
+		watch.fd = fd;
+		watch.events = POLLIN;
+		while (run)
+		{
+			watch.revents = 0;
+			int ret = poll(&watch, 1, 1000);
+			if (ret <= 0)
+			{
+				continue;
+			}
+			if (read(fd, buffer, sizeof(buffer)) <= 0)
+			{
+				break;
+			}
+			// editors write files in several steps, so wait until everything has settled
+			Utils::Utils::SleepForMilliseconds(100);
+			while (poll(&watch, 1, 0) > 0 && read(fd, buffer, sizeof(buffer)) > 0)
+			{
+			}
+			Load();
+		}
+		close(fd);
+	}
+#else
+	void FileCache::Watcher()
+	{
+	}
+#endif
+
+	const char* FileCache::ContentType(const string& name)
+	{
+		const size_t dot = name.rfind('.');
+		if (dot == string::npos)
+		{
+			return nullptr;
+		}
+		const string extension = name.substr(dot + 1);
+		if (extension.compare("ico") == 0)
+		{
+			return "image/x-icon";
+		}
+		if (extension.compare("css") == 0)
+		{
+			return "text/css";
+		}
+		if (extension.compare("png") == 0)
+		{
+			return "image/png";
+		}
+		if (extension.compare("ttf") == 0)
+		{
+			return "application/x-font-ttf";
+		}
+		if (extension.compare("js") == 0)
+		{
+			return "application/javascript";
+		}
+		if (extension.compare("svg") == 0)
+		{
+			return "image/svg+xml";
+		}
+		return nullptr;
+	}
+
+	bool FileCache::IsCompressible(const char* contentType)
+	{
+		// png is already compressed
+		return contentType != nullptr && string(contentType).compare("image/png") != 0;
+	}
+} // namespace WebServer
@@ -0,0 +1,74 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Logger/Logger.h"
+
+namespace WebServer
+{
+	// holds all static files of the html directory in memory together with a gzip compressed variant
+	class FileCache
+	{
+		public:
+			struct File
+			{
+				const char* contentType;
+				std::string content;
+				std::string etag;
+				// empty if compression does not make the file smaller
+				std::string contentGzip;
+				std::string etagGzip;
+			};
+
+			FileCache() = delete;
+			FileCache(const FileCache&) = delete;
+			FileCache& operator=(const FileCache&) = delete;
+			FileCache(const std::string& directory, const bool watch);
+			~FileCache();
+
+			// returns nullptr if the file does not exist
+			std::shared_ptr<const File> Get(const std::string& name);
+
+			// changes whenever any of the files changes, used to version the URLs of the main page
+			std::string Version();
+
+		private:
+			void Load();
+			void Watcher();
+			static const char* ContentType(const std::string& name);
+			static bool IsCompressible(const char* contentType);
+
+			const std::string directory;
+			Logger::Logger* logger;
+			std::map<std::string,std::shared_ptr<const File>> files;
+			std::string version;
+			std::mutex filesMutex;
+
+			volatile bool run;
+			std::thread watcherThread;
+	};
+} // namespace WebServer
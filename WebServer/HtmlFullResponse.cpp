@@ -18,7 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <string>
 
 #include "WebServer/HtmlFullResponse.h"
 
@@ -28,47 +28,40 @@ namespace WebServer
 	:	HtmlResponse(responseCode)
 	{}
 
-	HtmlFullResponse::HtmlFullResponse(const std::string& title, const HtmlTag body)
-	:	HtmlResponse(title, body)
+	HtmlFullResponse::HtmlFullResponse(const std::string& title, HtmlTag body)
+	:	HtmlResponse(title, std::move(body))
 	{}
 
-	HtmlFullResponse::HtmlFullResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
-	:	HtmlResponse(responseCode, title, body)
+	HtmlFullResponse::HtmlFullResponse(const std::string& title, HtmlTag body, const std::string& fileVersion)
+	:	HtmlResponse(title, std::move(body)),
+		fileVersion(fileVersion)
 	{}
 
-	HtmlFullResponse::operator std::string()
-	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
-	}
+	HtmlFullResponse::HtmlFullResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body)
+	:	HtmlResponse(responseCode, title, std::move(body))
+	{}
 
-	std::ostream& operator<<(std::ostream& stream, const HtmlFullResponse& response)
+	void HtmlFullResponse::Serialize(std::string& buffer) const
 	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << HtmlResponse::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
-		{
-			stream << header.first << ": " << header.second << "\r\n";
-		}
-
-		std::stringstream body;
-		body << "<!DOCTYPE html>";
+		std::string body("<!DOCTYPE html><html>");
+		const std::string version = fileVersion.size() > 0 ? "?v=" + fileVersion : "";
 
 		HtmlTag head("head");
-		head.AddChildTag(HtmlTag("title").AddId("title").AddContent(response.title));
-		head.AddChildTag(HtmlTag("link").AddAttribute("rel", "stylesheet").AddAttribute("type", "text/css").AddAttribute("href", "/style.css"));
-		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/nosleep.js"));
-		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/javascript.js"));
+		head.AddChildTag(HtmlTag("title").AddId("title").AddContent(title));
+		head.AddChildTag(HtmlTag("link").AddAttribute("rel", "stylesheet").AddAttribute("type", "text/css").AddAttribute("href", "/style.css" + version));
+		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/nosleep.js" + version));
+		head.AddChildTag(HtmlTag("script").AddAttribute("type", "application/javascript").AddAttribute("src", "/javascript.js" + version));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "viewport").AddAttribute("content", "width=device-width, initial-scale=1.0"));
 		head.AddChildTag(HtmlTag("meta").AddAttribute("name", "robots").AddAttribute("content", "noindex,nofollow"));
 
-		body << HtmlTag("html").AddChildTag(head).AddChildTag(response.content);
-
-		std::string bodyString(body.str());
+		head.Serialize(body);
+		content.Serialize(body);
+		body += "</html>";
 
-		stream << "Content-Length: " << bodyString.size();
-		stream << "\r\n\r\n";
-		stream << bodyString;
-		return stream;
+		SerializeHeaders(buffer);
+		buffer += "Content-Length: ";
+		buffer += std::to_string(body.size());
+		buffer += "\r\n\r\n";
+		buffer += body;
 	}
 } // namespace WebServer
@@ -32,12 +32,15 @@ namespace WebServer
 		public:
 			HtmlFullResponse() = delete;
 			HtmlFullResponse(const ResponseCode responseCode);
-			HtmlFullResponse(const std::string& title, const HtmlTag body);
-			HtmlFullResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body);
+			HtmlFullResponse(const std::string& title, HtmlTag body);
+			// fileVersion is appended to the URLs of the stylesheet and the scripts so they can be cached forever
+			HtmlFullResponse(const std::string& title, HtmlTag body, const std::string& fileVersion);
+			HtmlFullResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body);
 			~HtmlFullResponse() {};
-			operator std::string();
+			void Serialize(std::string& buffer) const override;
 
-			friend std::ostream& operator<<(std::ostream& stream, const HtmlFullResponse& response);
+		private:
+			std::string fileVersion;
 	};
 } // namespace WebServer
 
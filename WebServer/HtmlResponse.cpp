@@ -18,14 +18,14 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <string>
 
 #include "WebServer/HtmlResponse.h"
 
 namespace WebServer
 {
-	HtmlResponse::HtmlResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body)
-	:	Response(responseCode, body),
+	HtmlResponse::HtmlResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body)
+	:	Response(responseCode, std::move(body)),
 	 	title(title)
 	{
 		AddHeader("Cache-Control", "no-cache, must-revalidate");
@@ -42,41 +42,24 @@ namespace WebServer
 
 	void HtmlResponse::AddChildTag(HtmlTag content)
 	{
-		this->content.AddChildTag(content);
+		this->content.AddChildTag(std::move(content));
 	}
 
-	HtmlResponse::operator std::string()
+	void HtmlResponse::Serialize(std::string& buffer) const
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
-	}
-
-	std::ostream& operator<<(std::ostream& stream, const HtmlResponse& response)
-	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << HtmlResponse::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
-		{
-			stream << header.first << ": " << header.second << "\r\n";
-		}
-
-		std::stringstream body;
-		body << "<!DOCTYPE html>";
-
-		HtmlTag html("html");
-		if (response.title.length() > 0)
+		// content is serialized in place instead of being copied into an html tag
+		std::string body("<!DOCTYPE html><html>");
+		if (title.length() > 0)
 		{
-			HtmlTag head("head");
-			head.AddChildTag(HtmlTag("title").AddContent(response.title));
-			html.AddChildTag(head);
+			HtmlTag("head").AddChildTag(HtmlTag("title").AddContent(title)).Serialize(body);
 		}
-		html.AddChildTag(response.content);
-		body << html;
+		content.Serialize(body);
+		body += "</html>";
 
-		std::string bodyString(body.str());
-		stream << "Content-Length: " << bodyString.size();
-		stream << "\r\n\r\n";
-		stream << bodyString;
-		return stream;
+		SerializeHeaders(buffer);
+		buffer += "Content-Length: ";
+		buffer += std::to_string(body.size());
+		buffer += "\r\n\r\n";
+		buffer += body;
 	}
 } // namespace WebServer
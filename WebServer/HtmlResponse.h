@@ -35,21 +35,19 @@ namespace WebServer
 			:	HtmlResponse(responseCode, std::to_string(responseCode) + " " + HtmlResponse::responseTexts.at(responseCode), HtmlTag("body"))
 			{}
 
-			HtmlResponse(const HtmlTag body)
-			:	HtmlResponse("", body)
+			HtmlResponse(HtmlTag body)
+			:	HtmlResponse("", std::move(body))
 			{}
 
-			HtmlResponse(const std::string& title, const HtmlTag body)
-			:	HtmlResponse(Response::OK, title, body)
+			HtmlResponse(const std::string& title, HtmlTag body)
+			:	HtmlResponse(Response::OK, title, std::move(body))
 			{}
 
-			HtmlResponse(const ResponseCode responseCode, const std::string& title, const HtmlTag body);
+			HtmlResponse(const ResponseCode responseCode, const std::string& title, HtmlTag body);
 			virtual ~HtmlResponse() {};
 			void AddAttribute(const std::string name, const std::string value);
 			void AddChildTag(HtmlTag content);
-			operator std::string();
-
-			friend std::ostream& operator<<(std::ostream& stream, const HtmlResponse& response);
+			void Serialize(std::string& buffer) const override;
 
 		protected:
 			std::string title;
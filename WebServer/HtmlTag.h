@@ -22,7 +22,6 @@ along with RailControl; see the file LICENCE. If not see
 
 #include <map>
 #include <ostream>
-#include <sstream>
 #include <string>
 #include <vector>
 
@@ -45,29 +44,43 @@ namespace WebServer
 		public:
 			inline HtmlTag() {}
 			inline HtmlTag(const std::string& name) : name(name) {}
+			inline HtmlTag(const HtmlTag&) = default;
+			inline HtmlTag(HtmlTag&&) = default;
 			inline virtual ~HtmlTag() {};
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value = "");
+			inline HtmlTag& operator=(const HtmlTag&) = default;
+			inline HtmlTag& operator=(HtmlTag&&) = default;
 
-			inline virtual HtmlTag AddChildTag(const HtmlTag& child)
+			// all Add* methods modify the tag itself and return a reference to it,
+			// so chained calls do not copy the tag and its children
+
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value = "");
+
+			inline virtual HtmlTag& AddChildTag(const HtmlTag& child)
 			{
 				this->childTags.push_back(child);
 				return *this;
 			}
 
-			inline virtual HtmlTag AddContent(const std::string& content)
+			inline virtual HtmlTag& AddChildTag(HtmlTag&& child)
+			{
+				this->childTags.push_back(std::move(child));
+				return *this;
+			}
+
+			inline virtual HtmlTag& AddContent(const std::string& content)
 			{
 				this->content += content;
 				return *this;
 			}
 
 			template<typename... Args>
-			inline HtmlTag AddContent(const Languages::TextSelector text, Args... args)
+			inline HtmlTag& AddContent(const Languages::TextSelector text, Args... args)
 			{
-				return AddContent(Logger::Logger::Format(Languages::GetText(text), args...));
+				return AddContent(Logger::Logger::Format(text, args...));
 			}
 
-			inline virtual HtmlTag AddClass(const std::string& className)
+			inline virtual HtmlTag& AddClass(const std::string& className)
 			{
 				if (className.length() > 0)
 				{
@@ -76,7 +89,7 @@ namespace WebServer
 				return *this;
 			}
 
-			inline virtual HtmlTag AddId(const std::string& id)
+			inline virtual HtmlTag& AddId(const std::string& id)
 			{
 				this->id = id;
 				return *this;
@@ -84,11 +97,14 @@ namespace WebServer
 
 			inline virtual size_t ContentSize() const { return content.size(); }
 
+			// appends the tag with all its children to buffer
+			void Serialize(std::string& buffer) const;
+
 			inline operator std::string () const
 			{
-				std::stringstream ss;
-				ss << *this;
-				return ss.str();
+				std::string buffer;
+				Serialize(buffer);
+				return buffer;
 			}
 
 			friend std::ostream& operator<<(std::ostream& stream, const HtmlTag& tag);
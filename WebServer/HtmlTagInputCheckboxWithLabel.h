@@ -42,13 +42,13 @@ namespace WebServer
 
 			virtual ~HtmlTagInputCheckboxWithLabel() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[1].AddAttribute(name, value);
 				return *this;
 			}
 
-			virtual HtmlTag AddClass(const std::string& _class) override
+			virtual HtmlTag& AddClass(const std::string& _class) override
 			{
 				childTags[1].AddClass(_class);
 				return *this;
@@ -48,7 +48,7 @@ namespace WebServer
 			HtmlTagLabel(const Languages::TextSelector label, const std::string& reference, Args... args)
 			: HtmlTag("label")
 			{
-				std::string stringLabel = Logger::Logger::Format(Languages::GetText(label), args...);
+				std::string stringLabel = Logger::Logger::Format(label, args...);
 				stringLabel.append(":");
 				AddContent(stringLabel);
 				AddAttribute("for", reference);
@@ -43,13 +43,13 @@ namespace WebServer
 
 			virtual ~HtmlTagSelectOrientation() {}
 
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
 			}
 
-			virtual HtmlTag AddClass(const std::string& className) override
+			virtual HtmlTag& AddClass(const std::string& className) override
 			{
 				childTags[0].AddClass(className);
 				return *this;
@@ -32,7 +32,7 @@ namespace WebServer
 	class HtmlTagTrackBase : public HtmlTagLayoutItem
 	{
 		public:
-			virtual HtmlTag AddAttribute(const std::string& name, const std::string& value) override
+			virtual HtmlTag& AddAttribute(const std::string& name, const std::string& value) override
 			{
 				childTags[0].AddAttribute(name, value);
 				return *this;
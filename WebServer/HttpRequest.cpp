@@ -0,0 +1,350 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <strings.h>
+
+#include "Utils/Utils.h"
+#include "WebServer/HttpRequest.h"
+
+using std::map;
+using std::string;
+
+namespace WebServer
+{
+	HttpRequest::HttpRequest()
+	:	length(0),
+		scanned(0),
+		headSize(0),
+		bodySize(0),
+		head(false),
+		keepAlive(false)
+	{
+	}
+
+	char* HttpRequest::PrepareReceive(const size_t size)
+	{
+		if (buffer.size() < length + size)
+		{
+			buffer.resize(std::max(length + size, buffer.size() * 2));
+		}
+		return &buffer[length];
+	}
+
+	void HttpRequest::CommitReceive(const size_t size)
+	{
+		length += size;
+	}
+
+	HttpRequest::ParseResult HttpRequest::Parse()
+	{
+		if (headSize == 0)
+		{
+			// empty lines in front of a request have to be ignored
+			size_t skip = 0;
+			while (skip < length && (buffer[skip] == '\r' || buffer[skip] == '\n'))
+			{
+				++skip;
+			}
+			if (skip > 0)
+			{
+				memmove(&buffer[0], &buffer[skip], length - skip);
+				length -= skip;
+				scanned = 0;
+			}
+
+			// search the empty line at the end of the head, the part already searched is not searched again
+			size_t headEnd = 0;
+			for (size_t pos = (scanned > 2 ? scanned - 2 : 1); pos < length; ++pos)
+			{
+				if (buffer[pos] != '\n')
+				{
+					continue;
+				}
+				if (buffer[pos - 1] == '\n' || (pos >= 2 && buffer[pos - 1] == '\r' && buffer[pos - 2] == '\n'))
+				{
+					headEnd = pos + 1;
+					break;
+				}
+			}
+
+			if (headEnd == 0)
+			{
+				scanned = length;
+				return length > MaxHeadSize ? ParseInvalid : ParseIncomplete;
+			}
+
+			if (headEnd > MaxHeadSize || ParseHead(headEnd) == false)
+			{
+				return ParseInvalid;
+			}
+		}
+
+		if (length < headSize + bodySize)
+		{
+			return ParseIncomplete;
+		}
+
+		// only form data is interpreted as arguments
+		static const char* formContentType = "application/x-www-form-urlencoded";
+		static const size_t formContentTypeLength = strlen(formContentType);
+		Range contentType;
+		if (bodySize > 0
+			&& FindHeader("Content-Type", contentType)
+			&& contentType.length >= formContentTypeLength
+			&& strncasecmp(&buffer[contentType.begin], formContentType, formContentTypeLength) == 0)
+		{
+			ParseArguments(headSize, headSize + bodySize);
+		}
+		return ParseComplete;
+	}
+
+	void HttpRequest::Consume()
+	{
+		const size_t requestSize = std::min(headSize + bodySize, length);
+		length -= requestSize;
+		if (length > 0)
+		{
+			memmove(&buffer[0], &buffer[requestSize], length);
+		}
+		scanned = 0;
+		headSize = 0;
+		bodySize = 0;
+	}
+
+	bool HttpRequest::HasHeader(const char* name) const
+	{
+		Range value;
+		return FindHeader(name, value);
+	}
+
+	string HttpRequest::GetHeader(const char* name, const string& defaultValue) const
+	{
+		Range value;
+		if (FindHeader(name, value) == false)
+		{
+			return defaultValue;
+		}
+		return string(&buffer[value.begin], value.length);
+	}
+
+	bool HttpRequest::FindHeader(const char* name, Range& value) const
+	{
+		const size_t nameLength = strlen(name);
+		for (auto& header : headers)
+		{
+			if (header.name.length != nameLength || strncasecmp(&buffer[header.name.begin], name, nameLength) != 0)
+			{
+				continue;
+			}
+			value = header.value;
+			return true;
+		}
+		return false;
+	}
+
+	bool HttpRequest::ParseHead(const size_t headEnd)
+	{
+		headers.clear();
+		arguments.clear();
+
+		// request line: method, uri and protocol separated by spaces
+		size_t lineEnd = buffer.find('\n', 0);
+		size_t lineLength = (lineEnd > 0 && buffer[lineEnd - 1] == '\r') ? lineEnd - 1 : lineEnd;
+		const size_t methodEnd = buffer.find(' ', 0);
+		if (methodEnd == string::npos || methodEnd == 0 || methodEnd >= lineLength)
+		{
+			return false;
+		}
+		const size_t uriEnd = buffer.find(' ', methodEnd + 1);
+		if (uriEnd == string::npos || uriEnd == methodEnd + 1 || uriEnd >= lineLength)
+		{
+			return false;
+		}
+		method.assign(buffer, 0, methodEnd);
+		Utils::Utils::StringToUpper(method);
+		head = method.compare("HEAD") == 0;
+		uri.assign(buffer, methodEnd + 1, uriEnd - methodEnd - 1);
+		const bool http11 = buffer.compare(uriEnd + 1, lineLength - uriEnd - 1, "HTTP/1.1") == 0;
+
+		const size_t query = uri.find('?');
+		path.assign(uri, 0, query);
+		UrlDecode(path);
+		if (query != string::npos)
+		{
+			ParseArguments(methodEnd + 2 + query, uriEnd);
+		}
+
+		// header lines
+		size_t lineBegin = lineEnd + 1;
+		while (lineBegin < headEnd)
+		{
+			lineEnd = buffer.find('\n', lineBegin);
+			lineLength = lineEnd - lineBegin;
+			if (lineLength > 0 && buffer[lineEnd - 1] == '\r')
+			{
+				--lineLength;
+			}
+			const size_t colon = buffer.find(':', lineBegin);
+			if (colon < lineBegin + lineLength)
+			{
+				Header header;
+				header.name.begin = lineBegin;
+				header.name.length = colon - lineBegin;
+				size_t valueBegin = colon + 1;
+				size_t valueEnd = lineBegin + lineLength;
+				while (valueBegin < valueEnd && (buffer[valueBegin] == ' ' || buffer[valueBegin] == '\t'))
+				{
+					++valueBegin;
+				}
+				while (valueEnd > valueBegin && (buffer[valueEnd - 1] == ' ' || buffer[valueEnd - 1] == '\t'))
+				{
+					--valueEnd;
+				}
+				header.value.begin = valueBegin;
+				header.value.length = valueEnd - valueBegin;
+				headers.push_back(header);
+			}
+			lineBegin = lineEnd + 1;
+		}
+
+		// chunked bodies are not supported
+		if (HasHeader("Transfer-Encoding"))
+		{
+			return false;
+		}
+
+		bodySize = 0;
+		Range value;
+		if (FindHeader("Content-Length", value))
+		{
+			for (size_t pos = value.begin; pos < value.begin + value.length; ++pos)
+			{
+				const char c = buffer[pos];
+				if (c < '0' || c > '9')
+				{
+					return false;
+				}
+				bodySize = bodySize * 10 + (c - '0');
+				if (bodySize > MaxBodySize)
+				{
+					return false;
+				}
+			}
+		}
+
+		// HTTP/1.1 keeps the connection open if not requested otherwise, HTTP/1.0 only if requested
+		keepAlive = http11;
+		if (FindHeader("Connection", value))
+		{
+			if (value.length == 5 && strncasecmp(&buffer[value.begin], "close", 5) == 0)
+			{
+				keepAlive = false;
+			}
+			else if (value.length == 10 && strncasecmp(&buffer[value.begin], "keep-alive", 10) == 0)
+			{
+				keepAlive = true;
+			}
+		}
+
+		headSize = headEnd;
+		return true;
+	}
+
+	void HttpRequest::ParseArguments(const size_t begin, const size_t end)
+	{
+		size_t argumentBegin = begin;
+		while (argumentBegin < end)
+		{
+			size_t argumentEnd = buffer.find('&', argumentBegin);
+			if (argumentEnd == string::npos || argumentEnd > end)
+			{
+				argumentEnd = end;
+			}
+			if (argumentEnd > argumentBegin)
+			{
+				size_t equal = buffer.find('=', argumentBegin);
+				if (equal == string::npos || equal > argumentEnd)
+				{
+					equal = argumentEnd;
+				}
+				string key(buffer, argumentBegin, equal - argumentBegin);
+				UrlDecode(key);
+				string& value = arguments[key];
+				if (equal < argumentEnd)
+				{
+					value.assign(buffer, equal + 1, argumentEnd - equal - 1);
+					UrlDecode(value);
+				}
+				else
+				{
+					value.clear();
+				}
+			}
+			argumentBegin = argumentEnd + 1;
+		}
+	}
+
+	char HttpRequest::ConvertHexToInt(char c)
+	{
+		if (c >= 'a')
+		{
+			c -= 'a' - 10;
+		}
+		else if (c >= 'A')
+		{
+			c -= 'A' - 10;
+		}
+		else if (c >= '0')
+		{
+			c -= '0';
+		}
+
+		if (c > 15)
+		{
+			return 0;
+		}
+
+		return c;
+	}
+
+	void HttpRequest::UrlDecode(string& value)
+	{
+		// decode %20 and similar in place
+		size_t pos = value.find('%');
+		if (pos == string::npos)
+		{
+			return;
+		}
+		size_t out = pos;
+		while (pos < value.length())
+		{
+			if (value[pos] == '%' && pos + 2 < value.length())
+			{
+				value[out++] = ConvertHexToInt(value[pos + 1]) * 16 + ConvertHexToInt(value[pos + 2]);
+				pos += 3;
+				continue;
+			}
+			value[out++] = value[pos++];
+		}
+		value.resize(out);
+	}
+} // namespace WebServer
@@ -0,0 +1,107 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace WebServer
+{
+	// incremental parser for HTTP requests
+	// the received data is kept in one buffer that is reused for all requests of a connection,
+	// the request line and the headers are only referenced by their position in this buffer
+	class HttpRequest
+	{
+		public:
+			enum ParseResult : unsigned char
+			{
+				ParseIncomplete = 0,
+				ParseComplete,
+				ParseInvalid
+			};
+
+			HttpRequest();
+			HttpRequest(const HttpRequest&) = delete;
+			HttpRequest& operator=(const HttpRequest&) = delete;
+
+			// returns a buffer where up to size bytes can be received into, has to be followed by CommitReceive
+			char* PrepareReceive(const size_t size);
+			void CommitReceive(const size_t size);
+
+			// checks if a complete request is in the buffer and interprets it
+			ParseResult Parse();
+
+			// removes the current request from the buffer, data of pipelined requests stays
+			void Consume();
+
+			inline const std::string& GetMethod() const { return method; }
+			inline const std::string& GetUri() const { return uri; }
+			inline const std::string& GetPath() const { return path; }
+			inline bool IsHead() const { return head; }
+			inline bool IsKeepAlive() const { return keepAlive; }
+
+			// GET arguments and arguments of a form urlencoded POST body
+			inline const std::map<std::string,std::string>& GetArguments() const { return arguments; }
+
+			// header names are case insensitive
+			bool HasHeader(const char* name) const;
+			std::string GetHeader(const char* name, const std::string& defaultValue = "") const;
+
+			static void UrlDecode(std::string& value);
+
+		private:
+			struct Range
+			{
+				size_t begin;
+				size_t length;
+			};
+
+			struct Header
+			{
+				Range name;
+				Range value;
+			};
+
+			static const size_t MaxHeadSize = 16384;
+			static const size_t MaxBodySize = 1048576;
+
+			bool ParseHead(const size_t headEnd);
+			bool FindHeader(const char* name, Range& value) const;
+			void ParseArguments(const size_t begin, const size_t end);
+			static char ConvertHexToInt(char c);
+
+			// only the first length bytes of buffer contain received data, the rest is reserved for receiving
+			std::string buffer;
+			size_t length;
+			size_t scanned;
+			size_t headSize;
+			size_t bodySize;
+
+			std::vector<Header> headers;
+			std::string method;
+			std::string uri;
+			std::string path;
+			std::map<std::string,std::string> arguments;
+			bool head;
+			bool keepAlive;
+	};
+} // namespace WebServer
@@ -18,7 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
-#include <sstream>
+#include <string>
 
 #include "WebServer/Response.h"
 
@@ -26,8 +26,11 @@ namespace WebServer
 {
 	const Response::responseCodeMap Response::responseTexts = {
 		{ Response::OK, "OK" },
+		{ Response::NotModified, "Not Modified" },
+		{ Response::BadRequest, "Bad Request" },
 		{ Response::NotFound, "Not found"},
-		{ Response::NotImplemented, "Not Implemented"}
+		{ Response::NotImplemented, "Not Implemented"},
+		{ Response::ServiceUnavailable, "Service Unavailable"}
 	};
 
 	void Response::AddHeader(const std::string& key, const std::string& value)
@@ -35,22 +38,39 @@ namespace WebServer
 		headers[key] = value;
 	}
 
-	Response::operator std::string()
+	Response::operator std::string() const
 	{
-		std::stringstream reply;
-		reply << *this;
-		return reply.str();
+		std::string reply;
+		Serialize(reply);
+		return reply;
 	}
 
-	std::ostream& operator<<(std::ostream& stream, const Response& response)
+	void Response::SerializeHeaders(std::string& buffer) const
 	{
-		stream << "HTTP/1.1 " << response.responseCode << " " << Response::responseTexts.at(response.responseCode) << "\r\n";
-		for(auto header : response.headers)
+		buffer += "HTTP/1.1 ";
+		buffer += std::to_string(responseCode);
+		buffer += " ";
+		buffer += responseTexts.at(responseCode);
+		buffer += "\r\n";
+		for (const auto& header : headers)
 		{
-			stream << header.first << ": " << header.second << "\r\n";
+			buffer += header.first;
+			buffer += ": ";
+			buffer += header.second;
+			buffer += "\r\n";
 		}
-		stream << "\r\n";
-		stream << response.content;
+	}
+
+	void Response::Serialize(std::string& buffer) const
+	{
+		SerializeHeaders(buffer);
+		buffer += "\r\n";
+		content.Serialize(buffer);
+	}
+
+	std::ostream& operator<<(std::ostream& stream, const Response& response)
+	{
+		stream << static_cast<std::string>(response);
 		return stream;
 	}
 } // namespace WebServer
@@ -34,15 +34,21 @@ namespace WebServer
 			enum ResponseCode : unsigned short
 			{
 				OK = 200,
+				NotModified = 304,
+				BadRequest = 400,
 				NotFound = 404,
-				NotImplemented = 501
+				NotImplemented = 501,
+				ServiceUnavailable = 503
 			};
 
 			Response() : responseCode(OK) {}
-			Response(const ResponseCode responseCode, const HtmlTag& content) : responseCode(responseCode), content(content) {}
+			Response(const ResponseCode responseCode, HtmlTag content) : responseCode(responseCode), content(std::move(content)) {}
 			virtual ~Response() {};
 			void AddHeader(const std::string& key, const std::string& value);
-			operator std::string();
+			operator std::string() const;
+
+			// appends the complete response including the header to buffer
+			virtual void Serialize(std::string& buffer) const;
 
 			friend std::ostream& operator<<(std::ostream& stream, const Response& response);
 
@@ -53,6 +59,10 @@ namespace WebServer
 
 			std::map<const std::string,std::string> headers;
 			HtmlTag content;
+
+		protected:
+			// appends status line and headers without the terminating empty line
+			void SerializeHeaders(std::string& buffer) const;
 	};
 } // namespace WebServer
 
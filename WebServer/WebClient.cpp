@@ -68,10 +68,8 @@ using LayoutPosition = DataModel::LayoutItem::LayoutPosition;
 using LayoutItemSize = DataModel::LayoutItem::LayoutItemSize;
 using LayoutRotation = DataModel::LayoutItem::LayoutRotation;
 using Visible = DataModel::LayoutItem::Visible;
-using std::deque;
 using std::map;
 using std::string;
-using std::thread;
 using std::to_string;
 using std::vector;
 
@@ -79,619 +77,195 @@ namespace WebServer
 {
 	WebClient::~WebClient()
 	{
-		run = false;
-		clientThread.join();
-		connection->Terminate();
-	}
-
-	// worker is the thread that handles client requests
-	void WebClient::Worker()
-	{
-		Utils::Utils::SetThreadName("WebClient");
-		logger->Info(Languages::TextHttpConnectionOpen, id);
-		WorkerImpl();
 		logger->Info(Languages::TextHttpConnectionClose, id);
 	}
 
-	void WebClient::WorkerImpl()
+	bool WebClient::Work()
 	{
-		run = true;
-		bool keepalive = true;
-
-		while (run && keepalive)
+		char* buffer = request.PrepareReceive(ReceiveSize);
+		int ret = connection->Receive(buffer, ReceiveSize, 0);
+		if (ret < 0)
+		{
+			return errno == ETIMEDOUT;
+		}
+		if (streaming)
 		{
-			char buffer_in[4096];
-			memset(buffer_in, 0, sizeof(buffer_in));
+			// nothing is expected from the client of an event stream
+			return true;
+		}
+		request.CommitReceive(ret);
 
-			size_t pos = 0;
-			string s;
-			while (pos < sizeof(buffer_in) - 1 && s.find("\n\n") == string::npos && run)
+		while (true)
+		{
+			HttpRequest::ParseResult result = request.Parse();
+			if (result == HttpRequest::ParseIncomplete)
 			{
-				size_t ret = connection->Receive(buffer_in + pos, sizeof(buffer_in) - 1 - pos, 0);
-				if (ret == static_cast<size_t>(-1))
-				{
-					if (errno != ETIMEDOUT)
-					{
-						return;
-					}
-					if (run == false)
-					{
-						return;
-					}
-					continue;
-				}
-				pos += ret;
-				s = string(buffer_in);
-				Utils::Utils::ReplaceString(s, string("\r\n"), string("\n"));
-				Utils::Utils::ReplaceString(s, string("\r"), string("\n"));
+				// the rest of the request is handled when it arrives
+				return true;
 			}
 
-			deque<string> lines;
-			Utils::Utils::SplitString(s, string("\n"), lines);
-
-			if (lines.size() <= 1)
+			if (result == HttpRequest::ParseInvalid)
 			{
-				return;
+				HtmlResponse response(HtmlResponse::BadRequest);
+				connection->Send(response);
+				return false;
 			}
 
-			string method;
-			string uri;
-			string protocol;
-			map<string, string> arguments;
-			map<string, string> headers;
-			InterpretClientRequest(lines, method, uri, protocol, arguments, headers);
-			keepalive = (Utils::Utils::GetStringMapEntry(headers, "Connection", "close").compare("keep-alive") == 0);
-			logger->Info(Languages::TextHttpConnectionRequest, id, method, uri);
+			const string& method = request.GetMethod();
+			logger->Info(Languages::TextHttpConnectionRequest, id, method, request.GetUri());
 
 			// if method is not implemented
-			if ((method.compare("GET") != 0) && (method.compare("HEAD") != 0))
+			if ((method.compare("GET") != 0) && (method.compare("HEAD") != 0) && (method.compare("POST") != 0))
 			{
 				logger->Info(Languages::TextHttpConnectionNotImplemented, id, method);
 				HtmlResponseNotImplemented response(method);
 				connection->Send(response);
-				return;
+				return false;
 			}
+			headOnly = request.IsHead();
 
 			// handle requests
-			if (arguments["cmd"].compare("quit") == 0)
-			{
-				ReplyHtmlWithHeaderAndParagraph(Languages::TextStoppingRailControl);
-				stopRailControlWebserver();
-			}
-			else if (arguments["cmd"].compare("booster") == 0)
-			{
-				bool on = Utils::Utils::GetBoolMapEntry(arguments, "on");
-				if (on)
-				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
-					manager.Booster(ControlTypeWebserver, BoosterStateGo);
-				}
-				else
-				{
-					ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
-					manager.Booster(ControlTypeWebserver, BoosterStateStop);
-				}
-			}
-			else if (arguments["cmd"].compare("layeredit") == 0)
-			{
-				HandleLayerEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("layersave") == 0)
-			{
-				HandleLayerSave(arguments);
-			}
-			else if (arguments["cmd"].compare("layerlist") == 0)
-			{
-				HandleLayerList();
-			}
-			else if (arguments["cmd"].compare("layeraskdelete") == 0)
-			{
-				HandleLayerAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("layerdelete") == 0)
-			{
-				HandleLayerDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controledit") == 0)
-			{
-				HandleControlEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("controlsave") == 0)
-			{
-				HandleControlSave(arguments);
-			}
-			else if (arguments["cmd"].compare("controllist") == 0)
-			{
-				HandleControlList();
-			}
-			else if (arguments["cmd"].compare("controlaskdelete") == 0)
-			{
-				HandleControlAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("controldelete") == 0)
-			{
-				HandleControlDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("loco") == 0)
-			{
-				HandleLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("locospeed") == 0)
-			{
-				HandleLocoSpeed(arguments);
-			}
-			else if (arguments["cmd"].compare("locoorientation") == 0)
-			{
-				HandleLocoOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("locofunction") == 0)
-			{
-				HandleLocoFunction(arguments);
-			}
-			else if (arguments["cmd"].compare("locoedit") == 0)
-			{
-				HandleLocoEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("locosave") == 0)
-			{
-				HandleLocoSave(arguments);
-			}
-			else if (arguments["cmd"].compare("locolist") == 0)
-			{
-				HandleLocoList();
-			}
-			else if (arguments["cmd"].compare("locoaskdelete") == 0)
-			{
-				HandleLocoAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locodelete") == 0)
-			{
-				HandleLocoDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("locorelease") == 0)
-			{
-				HandleLocoRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryedit") == 0)
-			{
-				HandleAccessoryEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorysave") == 0)
-			{
-				HandleAccessorySave(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorystate") == 0)
-			{
-				HandleAccessoryState(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorylist") == 0)
-			{
-				HandleAccessoryList();
-			}
-			else if (arguments["cmd"].compare("accessoryaskdelete") == 0)
-			{
-				HandleAccessoryAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessorydelete") == 0)
-			{
-				HandleAccessoryDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryget") == 0)
-			{
-				HandleAccessoryGet(arguments);
-			}
-			else if (arguments["cmd"].compare("accessoryrelease") == 0)
-			{
-				HandleAccessoryRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("switchedit") == 0)
-			{
-				HandleSwitchEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("switchsave") == 0)
-			{
-				HandleSwitchSave(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstate") == 0)
-			{
-				HandleSwitchState(arguments);
-			}
-			else if (arguments["cmd"].compare("switchstates") == 0)
-			{
-				HandleSwitchStates(arguments);
-			}
-			else if (arguments["cmd"].compare("switchlist") == 0)
-			{
-				HandleSwitchList();
-			}
-			else if (arguments["cmd"].compare("switchaskdelete") == 0)
-			{
-				HandleSwitchAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchdelete") == 0)
-			{
-				HandleSwitchDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("switchget") == 0)
-			{
-				HandleSwitchGet(arguments);
-			}
-			else if (arguments["cmd"].compare("switchrelease") == 0)
-			{
-				HandleSwitchRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("signaledit") == 0)
-			{
-				signal.HandleSignalEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("signalsave") == 0)
-			{
-				signal.HandleSignalSave(arguments);
-			}
-			else if (arguments["cmd"].compare("signalstate") == 0)
-			{
-				signal.HandleSignalState(arguments);
-			}
-			else if (arguments["cmd"].compare("signallist") == 0)
-			{
-				signal.HandleSignalList();
-			}
-			else if (arguments["cmd"].compare("signalaskdelete") == 0)
-			{
-				signal.HandleSignalAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signaldelete") == 0)
-			{
-				signal.HandleSignalDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("signalget") == 0)
-			{
-				signal.HandleSignalGet(arguments);
-			}
-			else if (arguments["cmd"].compare("signalrelease") == 0)
-			{
-				signal.HandleSignalRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("routeedit") == 0)
-			{
-				HandleRouteEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("routesave") == 0)
-			{
-				HandleRouteSave(arguments);
-			}
-			else if (arguments["cmd"].compare("routelist") == 0)
-			{
-				HandleRouteList();
-			}
-			else if (arguments["cmd"].compare("routeaskdelete") == 0)
-			{
-				HandleRouteAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routedelete") == 0)
-			{
-				HandleRouteDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("routeget") == 0)
-			{
-				HandleRouteGet(arguments);
-			}
-			else if (arguments["cmd"].compare("routeexecute") == 0)
-			{
-				HandleRouteExecute(arguments);
-			}
-			else if (arguments["cmd"].compare("routerelease") == 0)
-			{
-				HandleRouteRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("trackedit") == 0)
-			{
-				track.HandleTrackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksave") == 0)
-			{
-				track.HandleTrackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("tracklist") == 0)
-			{
-				track.HandleTrackList();
-			}
-			else if (arguments["cmd"].compare("trackaskdelete") == 0)
-			{
-				track.HandleTrackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackdelete") == 0)
-			{
-				track.HandleTrackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("trackget") == 0)
-			{
-				track.HandleTrackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("tracksetloco") == 0)
-			{
-				track.HandleTrackSetLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackrelease") == 0)
-			{
-				track.HandleTrackRelease(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstartloco") == 0)
-			{
-				track.HandleTrackStartLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackstoploco") == 0)
-			{
-				track.HandleTrackStopLoco(arguments);
-			}
-			else if (arguments["cmd"].compare("trackblock") == 0)
-			{
-				track.HandleTrackBlock(arguments);
-			}
-			else if (arguments["cmd"].compare("trackorientation") == 0)
-			{
-				track.HandleTrackOrientation(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackedit") == 0)
-			{
-				HandleFeedbackEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksave") == 0)
-			{
-				HandleFeedbackSave(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackstate") == 0)
-			{
-				HandleFeedbackState(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacklist") == 0)
-			{
-				HandleFeedbackList();
-			}
-			else if (arguments["cmd"].compare("feedbackaskdelete") == 0)
-			{
-				HandleFeedbackAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackdelete") == 0)
-			{
-				HandleFeedbackDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackget") == 0)
-			{
-				HandleFeedbackGet(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbacksoftrack") == 0)
-			{
-				HandleFeedbacksOfTrack(arguments);
-			}
-			else if (arguments["cmd"].compare("protocol") == 0)
-			{
-				HandleProtocol(arguments);
-			}
-			else if (arguments["cmd"].compare("feedbackadd") == 0)
-			{
-				HandleFeedbackAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationadd") == 0)
-			{
-				HandleRelationAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("relationobject") == 0)
-			{
-				HandleRelationObject(arguments);
-			}
-			else if (arguments["cmd"].compare("layout") == 0)
-			{
-				HandleLayout(arguments);
-			}
-			else if (arguments["cmd"].compare("locoselector") == 0)
-			{
-				HandleLocoSelector();
-			}
-			else if (arguments["cmd"].compare("layerselector") == 0)
-			{
-				HandleLayerSelector();
-			}
-			else if (arguments["cmd"].compare("stopallimmediately") == 0)
-			{
-				manager.StopAllLocosImmediately(ControlTypeWebserver);
-			}
-			else if (arguments["cmd"].compare("startall") == 0)
-			{
-				manager.LocoStartAll();
-			}
-			else if (arguments["cmd"].compare("stopall") == 0)
-			{
-				manager.LocoStopAll();
-			}
-			else if (arguments["cmd"].compare("settingsedit") == 0)
-			{
-				HandleSettingsEdit();
-			}
-			else if (arguments["cmd"].compare("settingssave") == 0)
+			const map<string, string>& arguments = request.GetArguments();
+			auto handler = commandHandlers.find(Utils::Utils::GetStringMapEntry(arguments, "cmd"));
+			if (handler != commandHandlers.end())
 			{
-				HandleSettingsSave(arguments);
+				handler->second(*this, arguments, request);
 			}
-			else if (arguments["cmd"].compare("slaveadd") == 0)
-			{
-				HandleSlaveAdd(arguments);
-			}
-			else if (arguments["cmd"].compare("timestamp") == 0)
-			{
-				HandleTimestamp(arguments);
-			}
-			else if (arguments["cmd"].compare("controlarguments") == 0)
-			{
-				HandleControlArguments(arguments);
-			}
-			else if (arguments["cmd"].compare("program") == 0)
-			{
-				HandleProgram();
-			}
-			else if (arguments["cmd"].compare("programmodeselector") == 0)
-			{
-				HandleProgramModeSelector(arguments);
-			}
-			else if (arguments["cmd"].compare("programread") == 0)
-			{
-				HandleProgramRead(arguments);
-			}
-			else if (arguments["cmd"].compare("programwrite") == 0)
-			{
-				HandleProgramWrite(arguments);
-			}
-			else if (arguments["cmd"].compare("getcvfields") == 0)
-			{
-				HandleCvFields(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterlist") == 0)
-			{
-				cluster.HandleClusterList();
-			}
-			else if (arguments["cmd"].compare("clusteredit") == 0)
-			{
-				cluster.HandleClusterEdit(arguments);
-			}
-			else if (arguments["cmd"].compare("clustersave") == 0)
-			{
-				cluster.HandleClusterSave(arguments);
-			}
-			else if (arguments["cmd"].compare("clusteraskdelete") == 0)
-			{
-				cluster.HandleClusterAskDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("clusterdelete") == 0)
-			{
-				cluster.HandleClusterDelete(arguments);
-			}
-			else if (arguments["cmd"].compare("updater") == 0)
-			{
-				HandleUpdater(headers);
-			}
-			else if (uri.compare("/") == 0)
+			else if (request.GetPath().compare("/") == 0)
 			{
 				PrintMainHTML();
 			}
 			else
 			{
-				DeliverFile(uri);
-			}
-		}
-	}
-
-	char WebClient::ConvertHexToInt(char c)
-	{
-		if (c >= 'a')
-		{
-			c -= 'a' - 10;
-		}
-		else if (c >= 'A')
-		{
-			c -= 'A' - 10;
+				DeliverFile(request);
+			}
+
+			if (streaming)
+			{
+				return connection->IsConnected();
+			}
+
+			if (request.IsKeepAlive() == false || connection->IsConnected() == false)
+			{
+				return false;
+			}
+			request.Consume();
+		}
+	}
+
+	const CommandHandlers WebClient::commandHandlers = WebClient::CreateCommandHandlers();
+
+	CommandHandlers WebClient::CreateCommandHandlers()
+	{
+		CommandHandlers handlers;
+		handlers["quit"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleQuit(); };
+		handlers["booster"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleBooster(arguments); };
+		handlers["layeredit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLayerEdit(arguments); };
+		handlers["layersave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLayerSave(arguments); };
+		handlers["layerlist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleLayerList(); };
+		handlers["layeraskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLayerAskDelete(arguments); };
+		handlers["layerdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLayerDelete(arguments); };
+		handlers["controledit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleControlEdit(arguments); };
+		handlers["controlsave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleControlSave(arguments); };
+		handlers["controllist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleControlList(); };
+		handlers["controlaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleControlAskDelete(arguments); };
+		handlers["controldelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleControlDelete(arguments); };
+		handlers["loco"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLoco(arguments); };
+		handlers["locospeed"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoSpeed(arguments); };
+		handlers["locoorientation"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoOrientation(arguments); };
+		handlers["locofunction"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoFunction(arguments); };
+		handlers["locoedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoEdit(arguments); };
+		handlers["locosave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoSave(arguments); };
+		handlers["locolist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleLocoList(); };
+		handlers["locoaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoAskDelete(arguments); };
+		handlers["locodelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoDelete(arguments); };
+		handlers["locorelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleLocoRelease(arguments); };
+		handlers["accessoryedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryEdit(arguments); };
+		handlers["accessorysave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessorySave(arguments); };
+		handlers["accessorystate"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryState(arguments); };
+		handlers["accessorylist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleAccessoryList(); };
+		handlers["accessoryaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryAskDelete(arguments); };
+		handlers["accessorydelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryDelete(arguments); };
+		handlers["accessoryget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryGet(arguments); };
+		handlers["accessoryrelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleAccessoryRelease(arguments); };
+		handlers["switchedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchEdit(arguments); };
+		handlers["switchsave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchSave(arguments); };
+		handlers["switchstate"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchState(arguments); };
+		handlers["switchstates"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchStates(arguments); };
+		handlers["switchlist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleSwitchList(); };
+		handlers["switchaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchAskDelete(arguments); };
+		handlers["switchdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchDelete(arguments); };
+		handlers["switchget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchGet(arguments); };
+		handlers["switchrelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSwitchRelease(arguments); };
+		handlers["routeedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteEdit(arguments); };
+		handlers["routesave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteSave(arguments); };
+		handlers["routelist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleRouteList(); };
+		handlers["routeaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteAskDelete(arguments); };
+		handlers["routedelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteDelete(arguments); };
+		handlers["routeget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteGet(arguments); };
+		handlers["routeexecute"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteExecute(arguments); };
+		handlers["routerelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRouteRelease(arguments); };
+		handlers["feedbackedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackEdit(arguments); };
+		handlers["feedbacksave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackSave(arguments); };
+		handlers["feedbackstate"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackState(arguments); };
+		handlers["feedbacklist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleFeedbackList(); };
+		handlers["feedbackaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackAskDelete(arguments); };
+		handlers["feedbackdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackDelete(arguments); };
+		handlers["feedbackget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackGet(arguments); };
+		handlers["feedbacksoftrack"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbacksOfTrack(arguments); };
+		handlers["protocol"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleProtocol(arguments); };
+		handlers["feedbackadd"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleFeedbackAdd(arguments); };
+		handlers["relationadd"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRelationAdd(arguments); };
+		handlers["relationobject"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleRelationObject(arguments); };
+		handlers["layout"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest& request) { client.HandleLayout(arguments, request); };
+		handlers["locoselector"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleLocoSelector(); };
+		handlers["layerselector"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleLayerSelector(); };
+		handlers["stopallimmediately"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.manager.StopAllLocosImmediately(ControlTypeWebserver); };
+		handlers["startall"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.manager.LocoStartAll(); };
+		handlers["stopall"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.manager.LocoStopAll(); };
+		handlers["settingsedit"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleSettingsEdit(); };
+		handlers["settingssave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSettingsSave(arguments); };
+		handlers["slaveadd"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleSlaveAdd(arguments); };
+		handlers["timestamp"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleTimestamp(arguments); };
+		handlers["controlarguments"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleControlArguments(arguments); };
+		handlers["program"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.HandleProgram(); };
+		handlers["programmodeselector"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleProgramModeSelector(arguments); };
+		handlers["programread"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleProgramRead(arguments); };
+		handlers["programwrite"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleProgramWrite(arguments); };
+		handlers["getcvfields"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.HandleCvFields(arguments); };
+		handlers["updater"] = [](WebClient& client, const map<string, string>&, const HttpRequest& request) { client.HandleUpdater(request); };
+		WebClientSignal::RegisterCommands(handlers);
+		WebClientTrack::RegisterCommands(handlers);
+		WebClientCluster::RegisterCommands(handlers);
+		return handlers;
+	}
+
+	void WebClient::HandleQuit()
+	{
+		ReplyHtmlWithHeaderAndParagraph(Languages::TextStoppingRailControl);
+		stopRailControlWebserver();
+	}
+
+	void WebClient::HandleBooster(const map<string, string>& arguments)
+	{
+		bool on = Utils::Utils::GetBoolMapEntry(arguments, "on");
+		if (on)
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOn);
+			manager.Booster(ControlTypeWebserver, BoosterStateGo);
 		}
-		else if (c >= '0')
-		{
-			c -= '0';
-		}
-
-		if (c > 15)
-		{
-			return 0;
-		}
-
-		return c;
-	}
-
-	void WebClient::UrlDecode(string& argumentValue)
-	{
-		// decode %20 and similar
-		while (true)
-		{
-			size_t pos = argumentValue.find('%');
-			if (pos == string::npos || pos + 3 > argumentValue.length())
-			{
-				break;
-			}
-			char c = ConvertHexToInt(argumentValue[pos + 1]) * 16 + ConvertHexToInt(argumentValue[pos + 2]);
-			argumentValue.replace(pos, 3, 1, c);
-		}
-	}
-
-	void WebClient::InterpretClientRequest(const deque<string>& lines, string& method, string& uri, string& protocol, map<string,string>& arguments, map<string,string>& headers)
-	{
-		if (lines.size() == 0)
+		else
 		{
-			return;
-		}
-
-		for (auto line : lines)
-		{
-			if (line.find("HTTP/1.") == string::npos)
-			{
-				deque<string> list;
-				Utils::Utils::SplitString(line, string(": "), list);
-				if (list.size() == 2)
-				{
-					headers[list[0]] = list[1];
-				}
-				continue;
-			}
-
-			deque<string> list;
-			Utils::Utils::SplitString(line, string(" "), list);
-			if (list.size() != 3)
-			{
-				continue;
-			}
-
-			method = list[0];
-			// transform method to uppercase
-			std::transform(method.begin(), method.end(), method.begin(), ::toupper);
-
-			// if method == HEAD set membervariable
-			headOnly = method.compare("HEAD") == 0;
-
-			// set uri and protocol
-			uri = list[1];
-			UrlDecode(uri);
-			protocol = list[2];
-
-			// read GET-arguments from uri
-			deque<string> uriParts;
-			Utils::Utils::SplitString(uri, "?", uriParts);
-			if (uriParts.size() != 2)
-			{
-				continue;
-			}
-
-			deque<string> argumentStrings;
-			Utils::Utils::SplitString(uriParts[1], "&", argumentStrings);
-			for (auto argument : argumentStrings)
-			{
-				if (argument.length() == 0)
-				{
-					continue;
-				}
-				string key;
-				string value;
-				Utils::Utils::SplitString(argument, "=", key, value);
-				arguments[key] = value;
-			}
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextTurningBoosterOff);
+			manager.Booster(ControlTypeWebserver, BoosterStateStop);
 		}
 	}
 
-	void WebClient::DeliverFile(const string& virtualFile)
+	void WebClient::DeliverFile(const HttpRequest& request)
 	{
-		std::stringstream ss;
-		char workingDir[128];
-		if (getcwd(workingDir, sizeof(workingDir)))
-		{
-			ss << workingDir << "/html" << virtualFile;
-		}
-		string sFile = ss.str();
-		const char* realFile = sFile.c_str();
-		FILE* f = fopen(realFile, "r");
-		if (f == nullptr)
+		const string& virtualFile = request.GetPath();
+		std::shared_ptr<const FileCache::File> file = server.Files().Get(virtualFile);
+		if (file == nullptr)
 		{
 			HtmlResponseNotFound response(virtualFile);
 			connection->Send(response);
@@ -699,70 +273,46 @@ namespace WebServer
 			return;
 		}
 
-		DeliverFileInternal(f, realFile, virtualFile);
-		fclose(f);
-	}
+		const bool gzip = file->contentGzip.size() > 0
+			&& request.GetHeader("Accept-Encoding").find("gzip") != string::npos;
+		const string& etag = gzip ? file->etagGzip : file->etag;
+		const string& content = gzip ? file->contentGzip : file->content;
 
-	void WebClient::DeliverFileInternal(FILE* f, const char* realFile, const string& virtualFile)
-	{
-		struct stat s;
-		int rc = stat(realFile, &s);
-		if (rc != 0)
+		Response response;
+		// files requested with the version of the main page never change, all others have to be revalidated
+		if (request.GetArguments().count("v") == 1)
 		{
-			return;
+			response.AddHeader("Cache-Control", "public, max-age=31536000, immutable");
 		}
-
-		size_t length = virtualFile.length();
-		const char* contentType = nullptr;
-		if (length > 4 && virtualFile[length - 4] == '.')
+		else
 		{
-			if (virtualFile[length - 3] == 'i' && virtualFile[length - 2] == 'c' && virtualFile[length - 1] == 'o')
-			{
-				contentType = "image/x-icon";
-			}
-			else if (virtualFile[length - 3] == 'c' && virtualFile[length - 2] == 's' && virtualFile[length - 1] == 's')
-			{
-				contentType = "text/css";
-			}
-			else if (virtualFile[length - 3] == 'p' && virtualFile[length - 2] == 'n' && virtualFile[length - 1] == 'g')
-			{
-				contentType = "image/png";
-			}
-			else if (virtualFile[length - 3] == 't' && virtualFile[length - 2] == 't' && virtualFile[length - 1] == 'f')
-			{
-				contentType = "application/x-font-ttf";
-			}
+			response.AddHeader("Cache-Control", "no-cache");
 		}
-		else if (length > 3 && virtualFile[length - 3] == '.' && virtualFile[length - 2] == 'j' && virtualFile[length - 1] == 's')
+		response.AddHeader("ETag", etag);
+		response.AddHeader("Vary", "Accept-Encoding");
+		if (file->contentType != nullptr)
 		{
-			contentType = "application/javascript";
+			response.AddHeader("Content-Type", file->contentType);
 		}
 
-		Response response;
-		response.AddHeader("Cache-Control", "no-cache, must-revalidate");
-		response.AddHeader("Pragma", "no-cache");
-		response.AddHeader("Expires", "Sun, 12 Feb 2016 00:00:00 GMT");
-		response.AddHeader("Content-Length", to_string(s.st_size));
-		if (contentType != nullptr)
+		if (request.GetHeader("If-None-Match").compare(etag) == 0)
 		{
-			response.AddHeader("Content-Type", contentType);
+			response.responseCode = Response::NotModified;
+			connection->Send(response);
+			return;
 		}
-		connection->Send(response);
 
-		if (headOnly == true)
+		if (gzip)
 		{
-			return;
+			response.AddHeader("Content-Encoding", "gzip");
 		}
-
-		char* buffer = static_cast<char*>(malloc(s.st_size));
-		if (buffer == nullptr)
+		response.AddHeader("Content-Length", to_string(content.size()));
+		if (headOnly == true)
 		{
+			connection->Send(response);
 			return;
 		}
-
-		size_t r = fread(buffer, 1, s.st_size, f);
-		connection->Send(buffer, r, 0);
-		free(buffer);
+		connection->Send(response, content);
 	}
 
 	HtmlTag WebClient::HtmlTagControlArgument(const unsigned char argNr, const ArgumentType type, const string& value)
@@ -803,6 +353,31 @@ namespace WebServer
 				return HtmlTagInputIntegerWithLabel(argumentNumber, argumentName, valueInteger, 0, 62);
 			}
 
+			case ArgumentTypeFileName:
+				argumentName = Languages::TextFileName;
+				break;
+
+			case ArgumentTypeReplaySpeed:
+			{
+				argumentName = Languages::TextReplaySpeed;
+				const int valueInteger = Utils::Utils::StringToInteger(value, 1);
+				return HtmlTagInputIntegerWithLabel(argumentNumber, argumentName, valueInteger, 0, 1000);
+			}
+
+			case ArgumentTypeSectionTime:
+			{
+				argumentName = Languages::TextSectionTime;
+				const int valueInteger = Utils::Utils::StringToInteger(value, 2000);
+				return HtmlTagInputIntegerWithLabel(argumentNumber, argumentName, valueInteger, 10, 60000);
+			}
+
+			case ArgumentTypeMaxEnergisedAccessories:
+			{
+				argumentName = Languages::TextMaxEnergisedAccessories;
+				const int valueInteger = Utils::Utils::StringToInteger(value, 4);
+				return HtmlTagInputIntegerWithLabel(argumentNumber, argumentName, valueInteger, 1, 16);
+			}
+
 			default:
 				return HtmlTag();
 		}
@@ -989,10 +564,12 @@ namespace WebServer
 		hardwareList["Märklin Central Station 1 (CS1)"] = HardwareTypeEcos;
 		hardwareList["Märklin Central Station 2/3 (CS2/CS3) TCP"] = HardwareTypeCS2Tcp;
 		hardwareList["Märklin Central Station 2/3 (CS2/CS3) UDP"] = HardwareTypeCS2Udp;
+		hardwareList["Märklin Central Station 2/3 (CS2/CS3) Replay"] = HardwareTypeCS2Replay;
 		hardwareList["Märklin Interface 6050/6051"] = HardwareTypeM6051;
 		hardwareList["OpenDCC Z1"] = HardwareTypeOpenDcc;
 		hardwareList["RM485"] = HardwareTypeRM485;
 		hardwareList["Roco Z21"] = HardwareTypeZ21;
+		hardwareList["Simulation"] = HardwareTypeSimulation;
 		hardwareList["Virtual Command Station"] = HardwareTypeVirtual;
 		return hardwareList;
 	}
@@ -1042,7 +619,18 @@ namespace WebServer
 		controlArguments.AddChildTag(HtmlTagControlArguments(hardwareType, arg1, arg2, arg3, arg4, arg5));
 		form.AddChildTag(controlArguments);
 
-		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(form));
+		HtmlTag statisticsContent;
+		unsigned int sent;
+		unsigned int superseded;
+		unsigned int immediately;
+		if (controlID != ControlIdNone && manager.ControlCommandStatistics(controlID, sent, superseded, immediately))
+		{
+			statisticsContent.AddChildTag(HtmlTagTextWithLabel("commandssent", Languages::TextCommandsSent, to_string(sent)));
+			statisticsContent.AddChildTag(HtmlTagTextWithLabel("commandssuperseded", Languages::TextCommandsSuperseded, to_string(superseded)));
+			statisticsContent.AddChildTag(HtmlTagTextWithLabel("commandssentimmediately", Languages::TextCommandsSentImmediately, to_string(immediately)));
+		}
+
+		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(form).AddChildTag(statisticsContent));
 		content.AddChildTag(HtmlTagButtonCancel());
 		content.AddChildTag(HtmlTagButtonOK());
 		ReplyHtmlWithHeader(content);
@@ -2149,88 +1737,83 @@ namespace WebServer
 		return HtmlTagSelect("layer", options).AddAttribute("onchange", "loadLayout();");
 	}
 
-	void WebClient::HandleLayout(const map<string, string>& arguments)
+	void WebClient::HandleLayout(const map<string, string>& arguments, const HttpRequest& request)
 	{
 		LayerID layer = static_cast<LayerID>(Utils::Utils::GetIntegerMapEntry(arguments, "layer", CHAR_MIN));
-		HtmlTag content;
 
-		if (layer < LayerUndeletable)
+		// etag has to be read before rendering, a change while rendering must lead to a new etag
+		const string etag = server.LayoutETag();
+		if (request.GetHeader("If-None-Match").compare(etag) == 0)
 		{
-			const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
-			for (auto feedback : feedbacks)
-			{
-				if (feedback.second->GetControlID() != -layer)
-				{
-					continue;
-				}
-
-				content.AddChildTag(HtmlTagFeedbackOnControlLayer(feedback.second));
-			}
-			ReplyHtmlWithHeader(content);
+			Response response(Response::NotModified, HtmlTag());
+			response.AddHeader("ETag", etag);
+			connection->Send(response);
 			return;
 		}
 
-		const map<AccessoryID,DataModel::Accessory*>& accessories = manager.AccessoryList();
-		for (auto accessory : accessories)
+		string reply;
+		if (server.GetCachedLayout(layer, etag, reply))
 		{
-			if (accessory.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagAccessory(accessory.second));
+			connection->Send(reply);
+			return;
 		}
 
-		const map<SwitchID,DataModel::Switch*>& switches = manager.SwitchList();
-		for (auto mySwitch : switches)
-		{
-			if (mySwitch.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagSwitch(mySwitch.second));
-		}
+		HtmlResponse response(HtmlTagLayout(layer));
+		response.AddHeader("ETag", etag);
+		reply = response;
+		server.CacheLayout(layer, etag, reply);
+		connection->Send(reply);
+	}
 
-		const map<SwitchID,DataModel::Track*>& tracks = manager.TrackList();
-		for (auto track : tracks)
-		{
-			if (track.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagTrack(manager, track.second));
-		}
+	HtmlTag WebClient::HtmlTagLayout(const LayerID layer)
+	{
+		HtmlTag content;
 
-		const map<RouteID,DataModel::Route*>& routes = manager.RouteList();
-		for (auto route : routes)
+		if (layer < LayerUndeletable)
 		{
-			if (route.second->IsVisibleOnLayer(layer) == false)
+			const vector<const Feedback*> feedbacks = manager.FeedbacksOfControl(-layer);
+			for (auto feedback : feedbacks)
 			{
-				continue;
+				content.AddChildTag(HtmlTagFeedbackOnControlLayer(feedback));
 			}
-			content.AddChildTag(HtmlTagRoute(route.second));
+			return content;
 		}
 
-		const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
-		for (auto feedback : feedbacks)
+		const vector<const DataModel::LayoutItem*> items = manager.LayoutItemsOfLayer(layer);
+		for (auto item : items)
 		{
-			if (feedback.second->IsVisibleOnLayer(layer) == false)
+			switch (item->GetObjectType())
 			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagFeedback(feedback.second));
-		}
+				case ObjectTypeAccessory:
+					content.AddChildTag(HtmlTagAccessory(static_cast<const DataModel::Accessory*>(item)));
+					break;
 
-		const map<SignalID,DataModel::Signal*>& signals = manager.SignalList();
-		for (auto signal : signals)
-		{
-			if (signal.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
+				case ObjectTypeSwitch:
+					content.AddChildTag(HtmlTagSwitch(static_cast<const DataModel::Switch*>(item)));
+					break;
+
+				case ObjectTypeTrack:
+					content.AddChildTag(HtmlTagTrack(manager, static_cast<const DataModel::Track*>(item)));
+					break;
+
+				case ObjectTypeRoute:
+					content.AddChildTag(HtmlTagRoute(static_cast<const DataModel::Route*>(item)));
+					break;
+
+				case ObjectTypeFeedback:
+					content.AddChildTag(HtmlTagFeedback(static_cast<const DataModel::Feedback*>(item)));
+					break;
+
+				case ObjectTypeSignal:
+					content.AddChildTag(HtmlTagSignal(manager, static_cast<const DataModel::Signal*>(item)));
+					break;
+
+				default:
+					break;
 			}
-			content.AddChildTag(HtmlTagSignal(manager, signal.second));
 		}
 
-		ReplyHtmlWithHeader(content);
+		return content;
 	}
 
 	HtmlTag WebClient::HtmlTagControl(const std::map<ControlID,string>& controls, const ControlID controlID, const string& objectType, const ObjectID objectID)
@@ -3141,6 +2724,7 @@ namespace WebServer
 			}
 		}
 		bool inverted = false;
+		DataModel::Feedback::DebounceTime debounceTime = DataModel::Feedback::DefaultDebounceTime;
 		if (feedbackID > FeedbackNone)
 		{
 			const DataModel::Feedback* feedback = manager.GetFeedback(feedbackID);
@@ -3150,6 +2734,7 @@ namespace WebServer
 				controlId = feedback->GetControlID();
 				pin = feedback->GetPin();
 				inverted = feedback->GetInverted();
+				debounceTime = feedback->GetDebounceTime();
 				visible = feedback->GetVisible();
 				posx = feedback->GetPosX();
 				posy = feedback->GetPosY();
@@ -3176,6 +2761,7 @@ namespace WebServer
 		mainContent.AddChildTag(HtmlTagControlFeedback(controlId, "feedback", feedbackID));
 		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("pin", Languages::TextPin, pin, 1, 4096));
 		mainContent.AddChildTag(HtmlTagInputCheckboxWithLabel("inverted", Languages::TextInverted, "true", inverted));
+		mainContent.AddChildTag(HtmlTagInputIntegerWithLabel("debouncetime", Languages::TextDebounceTime, debounceTime, 0, DataModel::Feedback::MaxDebounceTime));
 		formContent.AddChildTag(mainContent);
 
 		formContent.AddChildTag(HtmlTagTabPosition(posx, posy, posz, visible));
@@ -3193,12 +2779,13 @@ namespace WebServer
 		ControlID controlId = Utils::Utils::GetIntegerMapEntry(arguments, "control", ControlIdNone);
 		FeedbackPin pin = static_cast<FeedbackPin>(Utils::Utils::GetIntegerMapEntry(arguments, "pin", FeedbackPinNone));
 		bool inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted");
+		DataModel::Feedback::DebounceTime debounceTime = DataModel::Feedback::LimitDebounceTime(Utils::Utils::GetIntegerMapEntry(arguments, "debouncetime", DataModel::Feedback::DefaultDebounceTime));
 		DataModel::LayoutItem::Visible visible = static_cast<Visible>(Utils::Utils::GetBoolMapEntry(arguments, "visible", DataModel::LayoutItem::VisibleNo));
 		LayoutPosition posX = Utils::Utils::GetIntegerMapEntry(arguments, "posx", 0);
 		LayoutPosition posY = Utils::Utils::GetIntegerMapEntry(arguments, "posy", 0);
 		LayoutPosition posZ = Utils::Utils::GetIntegerMapEntry(arguments, "posz", 0);
 		string result;
-		if (!manager.FeedbackSave(feedbackID, name, visible, posX, posY, posZ, controlId, pin, inverted, result))
+		if (!manager.FeedbackSave(feedbackID, name, visible, posX, posY, posZ, controlId, pin, inverted, debounceTime, result))
 		{
 			ReplyResponse(ResponseError, result);
 			return;
@@ -3358,7 +2945,15 @@ namespace WebServer
 		formContent.AddChildTag(HtmlTagNrOfTracksToReserve(nrOfTracksToReserve));
 		formContent.AddChildTag(HtmlTagLogLevel());
 
-		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(formContent));
+		HtmlTag connectionsContent;
+		connectionsContent.AddChildTag(HtmlTagTextWithLabel("activeclients", Languages::TextHttpConnectionsActive, to_string(server.GetActiveClients())));
+		connectionsContent.AddChildTag(HtmlTagTextWithLabel("totalclients", Languages::TextHttpConnectionsTotal, to_string(server.GetTotalClients())));
+		connectionsContent.AddChildTag(HtmlTagTextWithLabel("rejectedclients", Languages::TextHttpConnectionsRejected, to_string(server.GetRejectedClients())));
+		Logger::LoggerServer& loggerServer = Logger::LoggerServer::Instance();
+		connectionsContent.AddChildTag(HtmlTagTextWithLabel("writtenlogmessages", Languages::TextLogMessagesWritten, to_string(loggerServer.GetWrittenMessages())));
+		connectionsContent.AddChildTag(HtmlTagTextWithLabel("droppedlogmessages", Languages::TextLogMessagesDroppedTotal, to_string(loggerServer.GetDroppedMessages())));
+
+		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(formContent).AddChildTag(connectionsContent));
 		content.AddChildTag(HtmlTagButtonCancel());
 		content.AddChildTag(HtmlTagButtonOK());
 		ReplyHtmlWithHeader(content);
@@ -3687,7 +3282,7 @@ namespace WebServer
 		return ids;
 	}
 
-	void WebClient::HandleUpdater(const map<string, string>& headers)
+	void WebClient::HandleUpdater(const HttpRequest& request)
 	{
 		Response response;
 		response.AddHeader("Cache-Control", "no-cache, must-revalidate");
@@ -3700,32 +3295,19 @@ namespace WebServer
 			return;
 		}
 
-		unsigned int updateID = Utils::Utils::GetIntegerMapEntry(headers, "Last-Event-ID", 1);
-		while(run)
+		unsigned int updateID = Utils::Utils::StringToInteger(request.GetHeader("Last-Event-ID"), 0);
+		if (updateID == 0)
 		{
-			string s;
-			bool ok = server.NextUpdate(updateID, s);
-			if (ok == false)
-			{
-				// FIXME: use signaling instead of sleep
-				Utils::Utils::SleepForMilliseconds(100);
-				continue;
-			}
-
-			string reply("id: ");
-			reply += to_string(updateID);
-			reply += "\r\n";
-			reply += s;
-			reply += "\r\n\r\n";
-
+			updateID = server.FirstUpdateID();
+		}
+		else
+		{
+			// Last-Event-ID is the last update the client has received
 			++updateID;
-
-			ret = connection->Send(reply);
-			if (ret < 0)
-			{
-				return;
-			}
 		}
+		// the updates are sent by the webserver, the connection does not occupy a worker while waiting for them
+		streaming = true;
+		server.AddUpdateStream(connection, updateID);
 	}
 
 	void WebClient::ReplyHtmlWithHeader(const HtmlTag& tag)
@@ -3870,6 +3452,6 @@ namespace WebServer
 			.AddChildTag(HtmlTag("li").AddClass("contextentry").AddContent(Languages::GetText(Languages::TextAddFeedback)).AddAttribute("onClick", "loadPopup('/?cmd=feedbackedit&feedback=0');"))
 			));
 
-		connection->Send(HtmlFullResponse("RailControl", body));
+		connection->Send(HtmlFullResponse("RailControl", body, server.Files().Version()));
 	}
 } // namespace WebServer
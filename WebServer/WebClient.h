@@ -20,17 +20,17 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <deque>
 #include <map>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include "DataModel/AccessoryBase.h"
 #include "DataModel/ObjectIdentifier.h"
 #include "Manager.h"
 #include "Network/TcpConnection.h"
+#include "WebServer/CommandHandlers.h"
 #include "WebServer/HtmlResponse.h"
+#include "WebServer/HttpRequest.h"
 #include "WebServer/WebClientCluster.h"
 #include "WebServer/WebClientSignal.h"
 #include "WebServer/WebClientTrack.h"
@@ -64,25 +64,27 @@ namespace WebServer
 			:	logger(Logger::Logger::GetLogger("Webserver")),
 				id(id),
 				connection(connection),
-				run(false),
+				streaming(false),
 				server(webserver),
-				clientThread(&WebClient::Worker, this),
 				manager(manager),
 				cluster(manager, *this),
 				track(manager, *this, logger),
 				signal(manager, *this, logger),
 				headOnly(false),
 				buttonID(0)
-			{}
+			{
+				logger->Info(Languages::TextHttpConnectionOpen, id);
+			}
 
 			~WebClient();
 
-			void Worker();
+			// handles the data received on the connection, called by a worker of the webserver
+			// returns false if the connection has to be closed
+			bool Work();
 
-			inline void Stop()
-			{
-				run = false;
-			}
+			inline WebClientCluster& GetWebClientCluster() { return cluster; }
+			inline WebClientTrack& GetWebClientTrack() { return track; }
+			inline WebClientSignal& GetWebClientSignal() { return signal; }
 
 			void ReplyHtmlWithHeader(const HtmlTag& tag);
 
@@ -102,7 +104,7 @@ namespace WebServer
 			inline void ReplyResponse(ResponseType type, Languages::TextSelector text, Args... args)
 			{
 				std::string s(1, static_cast<unsigned char>(type));
-				s.append(Logger::Logger::Format(Languages::GetText(text), args...));
+				s.append(Logger::Logger::Format(text, args...));
 				ReplyResponse(s);
 			}
 
@@ -119,7 +121,7 @@ namespace WebServer
 			template<typename... Args>
 			inline void ReplyHtmlWithHeaderAndParagraph(const Languages::TextSelector text, Args... args)
 			{
-				ReplyHtmlWithHeaderAndParagraph(Logger::Logger::Format(Languages::GetText(text), args...));
+				ReplyHtmlWithHeaderAndParagraph(Logger::Logger::Format(text, args...));
 			}
 
 			HtmlTag HtmlTagTabMenuItem(const std::string& tabName,
@@ -155,11 +157,9 @@ namespace WebServer
 				const bool addDefault = true);
 
 		private:
-			void InterpretClientRequest(const std::deque<std::string>& lines, std::string& method, std::string& uri, std::string& protocol, std::map<std::string,std::string>& arguments, std::map<std::string,std::string>& headers);
 			void HandleLoco(const std::map<std::string, std::string>& arguments);
 			void PrintMainHTML();
-			void DeliverFile(const std::string& file);
-			void DeliverFileInternal(FILE* f, const char* realFile, const std::string& file);
+			void DeliverFile(const HttpRequest& request);
 			HtmlTag HtmlTagLocoSelector() const;
 			HtmlTag HtmlTagLayerSelector() const;
 			static HtmlTag HtmlTagControlArgument(const unsigned char argNr, const ArgumentType type, const std::string& value);
@@ -255,7 +255,8 @@ namespace WebServer
 			void HandleLocoDelete(const std::map<std::string, std::string>& arguments);
 			void HandleLocoRelease(const std::map<std::string, std::string>& arguments);
 			void HandleProtocol(const std::map<std::string, std::string>& arguments);
-			void HandleLayout(const std::map<std::string,std::string>& arguments);
+			void HandleLayout(const std::map<std::string,std::string>& arguments, const HttpRequest& request);
+			HtmlTag HtmlTagLayout(const LayerID layer);
 			void HandleAccessoryEdit(const std::map<std::string,std::string>& arguments);
 			void HandleAccessorySave(const std::map<std::string,std::string>& arguments);
 			void HandleAccessoryState(const std::map<std::string,std::string>& arguments);
@@ -304,23 +305,31 @@ namespace WebServer
 			void HandleProgramRead(const std::map<std::string,std::string>& arguments);
 			void HandleProgramWrite(const std::map<std::string,std::string>& arguments);
 			void HandleCvFields(const std::map<std::string,std::string>& arguments);
-			void HandleUpdater(const std::map<std::string,std::string>& headers);
-			static void UrlDecode(std::string& argumentValue);
-			static char ConvertHexToInt(char c);
-			void WorkerImpl();
+			void HandleUpdater(const HttpRequest& request);
+			void HandleQuit();
+			void HandleBooster(const std::map<std::string,std::string>& arguments);
+			static CommandHandlers CreateCommandHandlers();
 
 			Logger::Logger* logger;
 			unsigned int id;
+			// owned by the webserver
 			Network::TcpConnection* connection;
-			volatile unsigned char run;
+			// kept between the calls of Work because a request may arrive in several parts
+			HttpRequest request;
+			// the connection has become an event stream, the webserver sends the updates
+			bool streaming;
 			WebServer& server;
-			std::thread clientThread;
 			Manager& manager;
 			WebClientCluster cluster;
 			WebClientTrack track;
 			WebClientSignal signal;
 			bool headOnly;
 			unsigned int buttonID;
+
+			static const size_t ReceiveSize = 4096;
+
+			// all commands of the web interface, built once at startup
+			static const CommandHandlers commandHandlers;
 	};
 
 } // namespace WebServer
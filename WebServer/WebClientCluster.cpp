@@ -248,4 +248,13 @@ namespace WebServer
 		}
 		return signalOptions;
 	}
+
+	void WebClientCluster::RegisterCommands(CommandHandlers& handlers)
+	{
+		handlers["clusterlist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.GetWebClientCluster().HandleClusterList(); };
+		handlers["clusteredit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientCluster().HandleClusterEdit(arguments); };
+		handlers["clustersave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientCluster().HandleClusterSave(arguments); };
+		handlers["clusteraskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientCluster().HandleClusterAskDelete(arguments); };
+		handlers["clusterdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientCluster().HandleClusterDelete(arguments); };
+	}
 } // namespace WebServer
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <vector>
 
 #include "Manager.h"
+#include "WebServer/CommandHandlers.h"
 
 namespace WebServer
 {
@@ -44,6 +45,9 @@ namespace WebServer
 			void HandleClusterSave(const std::map<std::string,std::string>& arguments);
 			void HandleClusterAskDelete(const std::map<std::string,std::string>& arguments);
 			void HandleClusterDelete(const std::map<std::string,std::string>& arguments);
+
+			// adds the handlers of all commands of this class
+			static void RegisterCommands(CommandHandlers& handlers);
 			std::map<std::string,ObjectID> GetTrackOptions(const ClusterID clusterId = ClusterNone) const;
 			std::map<std::string,ObjectID> GetSignalOptions(const std::vector<DataModel::Relation*>&) const;
 
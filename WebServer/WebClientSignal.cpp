@@ -305,4 +305,16 @@ namespace WebServer
 		bool ret = manager.TrackBaseRelease(identifier);
 		client.ReplyHtmlWithHeaderAndParagraph(ret ? "Signal released" : "Signal not released");
 	}
+
+	void WebClientSignal::RegisterCommands(CommandHandlers& handlers)
+	{
+		handlers["signaledit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalEdit(arguments); };
+		handlers["signalsave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalSave(arguments); };
+		handlers["signalstate"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalState(arguments); };
+		handlers["signallist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.GetWebClientSignal().HandleSignalList(); };
+		handlers["signalaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalAskDelete(arguments); };
+		handlers["signaldelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalDelete(arguments); };
+		handlers["signalget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalGet(arguments); };
+		handlers["signalrelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientSignal().HandleSignalRelease(arguments); };
+	}
 } // namespace WebServer
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "Logger/Logger.h"
 #include "Manager.h"
+#include "WebServer/CommandHandlers.h"
 #include "WebServer/WebClientTrackBase.h"
 
 namespace WebServer
@@ -52,6 +53,9 @@ namespace WebServer
 			void HandleSignalRelease(const std::map<std::string, std::string>& arguments);
 			void HandleSignalState(const std::map<std::string, std::string>& arguments);
 
+			// adds the handlers of all commands of this class
+			static void RegisterCommands(CommandHandlers& handlers);
+
 		private:
 			Manager& manager;
 			WebClient& client;
@@ -443,4 +443,20 @@ namespace WebServer
 		manager.TrackBaseSetLocoOrientation(identifier, orientation);
 		client.ReplyHtmlWithHeaderAndParagraph("Loco orientation of track set");
 	}
+
+	void WebClientTrack::RegisterCommands(CommandHandlers& handlers)
+	{
+		handlers["trackedit"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackEdit(arguments); };
+		handlers["tracksave"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackSave(arguments); };
+		handlers["tracklist"] = [](WebClient& client, const map<string, string>&, const HttpRequest&) { client.GetWebClientTrack().HandleTrackList(); };
+		handlers["trackaskdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackAskDelete(arguments); };
+		handlers["trackdelete"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackDelete(arguments); };
+		handlers["trackget"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackGet(arguments); };
+		handlers["tracksetloco"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackSetLoco(arguments); };
+		handlers["trackrelease"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackRelease(arguments); };
+		handlers["trackstartloco"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackStartLoco(arguments); };
+		handlers["trackstoploco"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackStopLoco(arguments); };
+		handlers["trackblock"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackBlock(arguments); };
+		handlers["trackorientation"] = [](WebClient& client, const map<string, string>& arguments, const HttpRequest&) { client.GetWebClientTrack().HandleTrackOrientation(arguments); };
+	}
 } // namespace WebServer
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #include "Logger/Logger.h"
 #include "Manager.h"
+#include "WebServer/CommandHandlers.h"
 #include "WebServer/WebClientTrackBase.h"
 
 namespace WebServer
@@ -55,6 +56,9 @@ namespace WebServer
 			void HandleTrackBlock(const std::map<std::string, std::string>& arguments);
 			void HandleTrackOrientation(const std::map<std::string, std::string>& arguments);
 
+			// adds the handlers of all commands of this class
+			static void RegisterCommands(CommandHandlers& handlers);
+
 			std::map<std::string,ObjectID> GetSignalOptions(const TrackID trackId = TrackNone) const;
 
 		private:
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 #include <sstream>
 #include <sys/socket.h>
 #include <thread>
+#include <time.h>
 #include <unistd.h>
 
 #include "DataTypes.h"
@@ -32,6 +33,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Languages.h"
 #include "RailControl.h"
 #include "Utils/Utils.h"
+#include "WebServer/HtmlResponse.h"
 #include "WebServer/WebClient.h"
 #include "WebServer/WebServer.h"
 
@@ -48,20 +50,35 @@ using DataModel::TrackBase;
 
 namespace WebServer {
 
-	WebServer::WebServer(Manager& manager, const unsigned short port)
+	WebServer::WebServer(Manager& manager,
+		const unsigned short port,
+		const unsigned int maxUpdates,
+		const unsigned int maxClients,
+		const unsigned int workers,
+		const bool watchFiles)
 	:	ControlInterface(ControlTypeWebserver),
 		Network::TcpServer(port, "WebServer"),
 		run(false),
 		lastClientID(0),
+		rejectedClients(0),
+		maxClients(maxClients > 0 ? maxClients : 1),
 		manager(manager),
-		updateID(1)
+		updates(maxUpdates < InitialUpdates ? InitialUpdates : maxUpdates),
+		updateID(0),
+		maxUpdates(updates.size()),
+		updateStreamAdded(false),
+		layoutGeneration(0),
+		layoutETagPrefix("\"" + to_string(time(nullptr)) + "-"),
+		files("html", watchFiles)
 	{
 		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextWebServerStarted);
 		{
 			std::lock_guard<std::mutex> lock(updateMutex);
-			updates[updateID] = GetStatus(Languages::TextRailControlStarted);
+			StoreUpdate(GetStatus(Languages::TextRailControlStarted));
 		}
 		run = true;
+		updateSenderThread = std::thread(&WebServer::UpdateSender, this);
+		StartTcpServer(workers);
 	}
 
 	WebServer::~WebServer()
@@ -72,31 +89,78 @@ namespace WebServer {
 		}
 		{
 			std::lock_guard<std::mutex> lock(updateMutex);
-			updates[++updateID] = GetStatus(Languages::TextStoppingRailControl);
+			StoreUpdate(GetStatus(Languages::TextStoppingRailControl));
 		}
-		TerminateTcpServer();
+		updateCondition.notify_all();
+		// gives the update sender the time to deliver the last update
 		Utils::Utils::SleepForSeconds(1);
-		run = false;
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			run = false;
+		}
+		updateCondition.notify_all();
+		updateSenderThread.join();
 
-		// stopping all clients
-		for (auto client : clients)
+		// deletes all clients with their connections
+		TerminateTcpServer();
+		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextWebServerStopped);
+	}
+
+	bool WebServer::Connected(Network::TcpConnection* connection)
+	{
+		std::lock_guard<std::mutex> guard(clientsMutex);
+		++lastClientID;
+		if (clients.size() >= maxClients)
 		{
-			client->Stop();
+			++rejectedClients;
+			Logger::Logger::GetLogger("Webserver")->Warning(Languages::TextHttpConnectionRejected, lastClientID, maxClients);
+			connection->Send(HtmlResponse(HtmlResponse::ServiceUnavailable));
+			return false;
 		}
+		clients[connection] = new WebClient(lastClientID, connection, *this, manager);
+		return true;
+	}
 
-		// delete all client memory
-		while (clients.size())
+	bool WebServer::Work(Network::TcpConnection* connection)
+	{
+		WebClient* client;
 		{
-			WebClient* client = clients.back();
-			clients.pop_back();
-			delete client;
+			std::lock_guard<std::mutex> guard(clientsMutex);
+			auto entry = clients.find(connection);
+			if (entry == clients.end())
+			{
+				return false;
+			}
+			client = entry->second;
 		}
-		Logger::Logger::GetLogger("Webserver")->Info(Languages::TextWebServerStopped);
+		// the client is deleted only after Work has returned
+		return client->Work();
 	}
 
-	void WebServer::Work(Network::TcpConnection* connection)
+	void WebServer::Disconnected(Network::TcpConnection* connection)
 	{
-		clients.push_back(new WebClient(++lastClientID, connection, *this, manager));
+		{
+			std::lock_guard<std::mutex> guard(updateStreamsMutex);
+			updateStreams.erase(connection);
+		}
+		WebClient* client = nullptr;
+		{
+			std::lock_guard<std::mutex> guard(clientsMutex);
+			auto entry = clients.find(connection);
+			if (entry == clients.end())
+			{
+				return;
+			}
+			client = entry->second;
+			clients.erase(entry);
+		}
+		delete client;
+	}
+
+	unsigned int WebServer::GetActiveClients()
+	{
+		std::lock_guard<std::mutex> guard(clientsMutex);
+		return clients.size();
 	}
 
 	void WebServer::Booster(__attribute__((unused)) const ControlType controlType, const BoosterState status)
@@ -137,6 +201,7 @@ namespace WebServer {
 
 	void WebServer::AccessoryState(__attribute__((unused)) const ControlType controlType, const DataModel::Accessory* accessory)
 	{
+		LayoutChanged();
 		stringstream command;
 		const DataModel::AccessoryState state = accessory->GetAccessoryState();
 		command << "accessory;accessory=" << accessory->GetID() << ";state=" << (state == DataModel::AccessoryStateOn ? "green" : "red");
@@ -145,6 +210,7 @@ namespace WebServer {
 
 	void WebServer::AccessorySettings(const AccessoryID accessoryID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "accessorysettings;accessory=" << accessoryID;
 		AddUpdate(command.str(), Languages::TextAccessoryUpdated, name);
@@ -152,6 +218,7 @@ namespace WebServer {
 
 	void WebServer::AccessoryDelete(const AccessoryID accessoryID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "accessorydelete;accessory=" << accessoryID;
 		AddUpdate(command.str(), Languages::TextAccessoryDeleted, name);
@@ -159,6 +226,7 @@ namespace WebServer {
 
 	void WebServer::FeedbackState(const std::string& name, const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "feedback;feedback=" << feedbackID << ";state=" << (state ? "on" : "off");
 		AddUpdate(command.str(), state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, name);
@@ -166,6 +234,7 @@ namespace WebServer {
 
 	void WebServer::FeedbackSettings(const FeedbackID feedbackID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "feedbacksettings;feedback=" << feedbackID;
 		AddUpdate(command.str(), Languages::TextFeedbackUpdated, name);
@@ -173,6 +242,7 @@ namespace WebServer {
 
 	void WebServer::FeedbackDelete(const FeedbackID feedbackID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "feedbackdelete;feedback=" << feedbackID;
 		AddUpdate(command.str(), Languages::TextFeedbackDeleted, name);
@@ -180,6 +250,7 @@ namespace WebServer {
 
 	void WebServer::RouteSettings(const RouteID routeID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "routesettings;route=" << routeID;
 		AddUpdate(command.str(), Languages::TextRouteUpdated, name);
@@ -187,6 +258,7 @@ namespace WebServer {
 
 	void WebServer::RouteDelete(const RouteID routeID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "routedelete;route=" << routeID;
 		AddUpdate(command.str(), Languages::TextRouteDeleted, name);
@@ -194,6 +266,7 @@ namespace WebServer {
 
 	void WebServer::SwitchState(__attribute__((unused)) const ControlType controlType, const DataModel::Switch* mySwitch)
 	{
+		LayoutChanged();
 		stringstream command;
 		const DataModel::AccessoryState state = mySwitch->GetAccessoryState();
 		command << "switch;switch=" << mySwitch->GetID() << ";state=";
@@ -221,6 +294,7 @@ namespace WebServer {
 
 	void WebServer::SwitchSettings(const SwitchID switchID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "switchsettings;switch=" << switchID;
 		AddUpdate(command.str(), Languages::TextSwitchUpdated, name);
@@ -228,6 +302,7 @@ namespace WebServer {
 
 	void WebServer::SwitchDelete(const SwitchID switchID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "switchdelete;switch=" << switchID;
 		AddUpdate(command.str(), Languages::TextSwitchDeleted, name);
@@ -235,6 +310,7 @@ namespace WebServer {
 
 	void WebServer::TrackState(const DataModel::Track* track)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "trackstate;track=" << track->GetID();
 		TrackBaseState(command, dynamic_cast<const DataModel::TrackBase*>(track));
@@ -293,6 +369,7 @@ namespace WebServer {
 
 	void WebServer::TrackSettings(const TrackID trackID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "tracksettings;track=" << trackID;
 		AddUpdate(command.str(), Languages::TextTrackUpdated, name);
@@ -300,6 +377,7 @@ namespace WebServer {
 
 	void WebServer::TrackDelete(const TrackID trackID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "trackdelete;track=" << trackID;
 		AddUpdate(command.str(), Languages::TextTrackDeleted, name);
@@ -307,6 +385,7 @@ namespace WebServer {
 
 	void WebServer::SignalState(__attribute__((unused)) const ControlType controlType, const DataModel::Signal* signal)
 	{
+		LayoutChanged();
 		stringstream command;
 		const DataModel::AccessoryState state = signal->GetAccessoryState();
 		command << "signal;signal=" << signal->GetID() << ";state=" << (state ? "green" : "red");
@@ -318,6 +397,7 @@ namespace WebServer {
 
 	void WebServer::SignalSettings(const SignalID signalID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "signalsettings;signal=" << signalID;
 		AddUpdate(command.str(), Languages::TextSignalUpdated, name);
@@ -325,6 +405,7 @@ namespace WebServer {
 
 	void WebServer::SignalDelete(const SignalID signalID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "signaldelete;signal=" << signalID;
 		AddUpdate(command.str(), Languages::TextSignalDeleted, name);
@@ -332,6 +413,7 @@ namespace WebServer {
 
 	void WebServer::ClusterSettings(const ClusterID clusterID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "clustersettings;cluster=" << clusterID;
 		AddUpdate(command.str(), Languages::TextClusterUpdated, name);
@@ -339,6 +421,7 @@ namespace WebServer {
 
 	void WebServer::ClusterDelete(const ClusterID clusterID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "clusterdelete;cluster=" << clusterID;
 		AddUpdate(command.str(), Languages::TextClusterDeleted, name);
@@ -346,6 +429,7 @@ namespace WebServer {
 
 	void WebServer::LocoRelease(const LocoID locoID)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "locorelease;loco=" << locoID;
 		AddUpdate(command.str(), Languages::TextLocoIsReleased, manager.GetLocoName(locoID));
@@ -353,6 +437,7 @@ namespace WebServer {
 
 	void WebServer::RouteRelease(const RouteID routeID)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "routeRelease;route=" << routeID;
 		AddUpdate(command.str(), Languages::TextRouteIsReleased, manager.GetRouteName(routeID));
@@ -376,6 +461,13 @@ namespace WebServer {
 		AddUpdate(command.str(), Languages::TextLocoIsInAutoMode, name);
 	}
 
+	void WebServer::LocoStatesSent(const unsigned int sent, const unsigned int total)
+	{
+		stringstream command;
+		command << "locostatessent;sent=" << sent << ";total=" << total;
+		AddUpdate(command.str(), Languages::TextLocoStatesSent, sent, total);
+	}
+
 	void WebServer::LocoStop(const LocoID locoID, const std::string& name)
 	{
 		stringstream command;
@@ -385,6 +477,7 @@ namespace WebServer {
 
 	void WebServer::LocoSettings(const LocoID locoID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "locosettings;loco=" << locoID;
 		AddUpdate(command.str(), Languages::TextLocoUpdated, name);
@@ -392,6 +485,7 @@ namespace WebServer {
 
 	void WebServer::LocoDelete(const LocoID locoID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "locodelete;loco=" << locoID;
 		AddUpdate(command.str(), Languages::TextLocoDeleted, name);
@@ -399,6 +493,7 @@ namespace WebServer {
 
 	void WebServer::LayerSettings(const LayerID layerID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "layersettings;layer=" << layerID;
 		AddUpdate(command.str(), Languages::TextLayerUpdated, name);
@@ -406,6 +501,7 @@ namespace WebServer {
 
 	void WebServer::LayerDelete(const LayerID layerID, const std::string& name)
 	{
+		LayoutChanged();
 		stringstream command;
 		command << "layerdelete;layer=" << layerID;
 		AddUpdate(command.str(), Languages::TextLayerDeleted, name);
@@ -418,31 +514,146 @@ namespace WebServer {
 		AddUpdate(command.str(), Languages::TextProgramReadValue , static_cast<int>(cv), static_cast<int>(value));
 	}
 
+	string WebServer::LayoutETag()
+	{
+		std::lock_guard<std::mutex> guard(layoutCacheMutex);
+		return layoutETagPrefix + to_string(layoutGeneration) + "-" + to_string(Languages::GetDefaultLanguage()) + "\"";
+	}
+
+	bool WebServer::GetCachedLayout(const LayerID layer, const string& etag, string& response)
+	{
+		std::lock_guard<std::mutex> guard(layoutCacheMutex);
+		auto entry = layoutCache.find(layer);
+		if (entry == layoutCache.end() || entry->second.first.compare(etag) != 0)
+		{
+			return false;
+		}
+		response = entry->second.second;
+		return true;
+	}
+
+	void WebServer::CacheLayout(const LayerID layer, const string& etag, const string& response)
+	{
+		std::lock_guard<std::mutex> guard(layoutCacheMutex);
+		layoutCache[layer] = std::make_pair(etag, response);
+	}
+
+	void WebServer::LayoutChanged()
+	{
+		std::lock_guard<std::mutex> guard(layoutCacheMutex);
+		++layoutGeneration;
+		layoutCache.clear();
+	}
+
 	void WebServer::AddUpdate(const string& command, const string& status)
 	{
 		stringstream ss;
 		ss << "data: command=" << command << ";status=" << status << "\r\n\r\n";
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			StoreUpdate(ss.str());
+		}
+		updateCondition.notify_all();
+	}
+
+	void WebServer::StoreUpdate(const string& update)
+	{
+		// updateMutex has to be locked by caller
+		++updateID;
+		updates[updateID % maxUpdates] = update;
+	}
+
+	unsigned int WebServer::FirstUpdateID()
+	{
 		std::lock_guard<std::mutex> lock(updateMutex);
-		updates[++updateID] = ss.str();
-		updates.erase(updateID - MaxUpdates);
+		return updateID > InitialUpdates ? updateID - InitialUpdates + 1 : 1;
+	}
+
+	void WebServer::AddUpdateStream(Network::TcpConnection* connection, const unsigned int updateID)
+	{
+		{
+			std::lock_guard<std::mutex> guard(updateStreamsMutex);
+			UpdateStream& stream = updateStreams[connection];
+			stream.updateID = updateID;
+			stream.pending.clear();
+		}
+		{
+			std::lock_guard<std::mutex> lock(updateMutex);
+			updateStreamAdded = true;
+		}
+		updateCondition.notify_all();
 	}
 
-	bool WebServer::NextUpdate(unsigned int& updateIDClient, string& s)
+	void WebServer::CollectUpdates(unsigned int& updateIDClient, string& s)
 	{
 		std::lock_guard<std::mutex> lock(updateMutex);
+		if (updateIDClient > updateID + 1)
+		{
+			// client knows IDs of a previous run of RailControl
+			updateIDClient = 1;
+		}
 
-		if (updateIDClient + MaxUpdates <= updateID)
+		const unsigned int tail = updateID >= maxUpdates ? updateID - maxUpdates + 1 : 1;
+		if (updateIDClient < tail)
 		{
-			updateIDClient = updateID - MaxUpdates + 1;
+			s += "data: command=resync;status=";
+			s += Logger::Logger::Format(Languages::TextUpdatesLost, tail - updateIDClient);
+			s += "\r\n\r\n";
+			updateIDClient = tail;
 		}
 
-		if (updates.count(updateIDClient) == 1)
+		for (; updateIDClient <= updateID; ++updateIDClient)
 		{
-			s = updates.at(updateIDClient);
-			return true;
+			s += "id: ";
+			s += to_string(updateIDClient);
+			s += "\r\n";
+			s += updates[updateIDClient % maxUpdates];
+			s += "\r\n\r\n";
 		}
+	}
 
-		return false;
+	void WebServer::UpdateSender()
+	{
+		Utils::Utils::SetThreadName("WebUpdates");
+		unsigned int sentUpdateID = 0;
+		bool pending = false;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(updateMutex);
+				// a stream whose socket could not take all data is retried after a short time
+				const std::chrono::milliseconds timeout(pending ? UpdateRetryInterval : UpdateWaitTimeout * 1000);
+				updateCondition.wait_for(lock, timeout, [&] { return run == false || updateID != sentUpdateID || updateStreamAdded; });
+				if (run == false)
+				{
+					return;
+				}
+				sentUpdateID = updateID;
+				updateStreamAdded = false;
+			}
+
+			pending = false;
+			std::lock_guard<std::mutex> guard(updateStreamsMutex);
+			for (auto& entry : updateStreams)
+			{
+				UpdateStream& stream = entry.second;
+				if (stream.pending.empty())
+				{
+					CollectUpdates(stream.updateID, stream.pending);
+				}
+				if (stream.pending.empty())
+				{
+					continue;
+				}
+				// a slow client must not delay the others, it falls behind and gets a resync later
+				int ret = entry.first->Send(stream.pending, MSG_DONTWAIT);
+				if (ret > 0)
+				{
+					stream.pending.erase(0, ret);
+				}
+				pending |= (stream.pending.empty() == false);
+			}
+		}
 	}
 
 } // namespace WebServer
@@ -20,9 +20,11 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "ControlInterface.h"
@@ -30,6 +32,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Logger/Logger.h"
 #include "Manager.h"
 #include "Network/TcpServer.h"
+#include "WebServer/FileCache.h"
 
 namespace WebServer
 {
@@ -39,12 +42,30 @@ namespace WebServer
 	{
 		public:
 			WebServer() = delete;
-			WebServer(Manager& manager, const unsigned short port);
+			WebServer(Manager& manager,
+				const unsigned short port,
+				const unsigned int maxUpdates,
+				const unsigned int maxClients,
+				const unsigned int workers,
+				const bool watchFiles);
 			~WebServer();
 
-			void Work(Network::TcpConnection* connection) override;
+			unsigned int GetActiveClients();
+			inline unsigned int GetTotalClients() const { return lastClientID; }
+			inline unsigned int GetRejectedClients() const { return rejectedClients; }
 
-			bool NextUpdate(unsigned int& updateIDClient, std::string& s);
+			// returns the update ID a new client without Last-Event-ID starts with
+			unsigned int FirstUpdateID();
+			// the updates starting with updateID are sent to connection until it is closed
+			void AddUpdateStream(Network::TcpConnection* connection, const unsigned int updateID);
+
+			// returns the entity tag of the current layout generation
+			std::string LayoutETag();
+			// returns true and the serialized response if layer was cached with etag
+			bool GetCachedLayout(const LayerID layer, const std::string& etag, std::string& response);
+			void CacheLayout(const LayerID layer, const std::string& etag, const std::string& response);
+
+			inline FileCache& Files() { return files; }
 
 			const std::string GetName() const override { return "Webserver"; }
 			void AccessoryDelete(const AccessoryID accessoryID, const std::string& name) override;
@@ -69,6 +90,7 @@ namespace WebServer
 			void LocoSettings(const LocoID locoID, const std::string& name) override;
 			void LocoSpeed(const ControlType controlType, const DataModel::Loco* loco, const Speed speed) override;
 			void LocoStart(const LocoID locoID, const std::string& name) override;
+			void LocoStatesSent(const unsigned int sent, const unsigned int total) override;
 			void LocoStop(const LocoID locoID, const std::string& name) override;
 			void RouteDelete(const RouteID routeID, const std::string& name) override;
 			void RouteRelease(const RouteID routeID) override;
@@ -87,25 +109,70 @@ namespace WebServer
 			void ProgramValue(const CvNumber cv, const CvValue value) override;
 
 		private:
+			bool Connected(Network::TcpConnection* connection) override;
+			bool Work(Network::TcpConnection* connection) override;
+			void Disconnected(Network::TcpConnection* connection) override;
+
 			template<typename... Args> void AddUpdate(const std::string& command, const Languages::TextSelector text, Args... args)
 			{
-				AddUpdate(command, Logger::Logger::Format(Languages::GetText(text), args...));
+				AddUpdate(command, Logger::Logger::Format(text, args...));
 			}
 			void AddUpdate(const std::string& command, const std::string& status);
+			void StoreUpdate(const std::string& update);
 			std::string GetStatus(Languages::TextSelector status) { return updateStatus + Languages::GetText(status); }
 
 			void TrackBaseState(std::stringstream& command, const DataModel::TrackBase* track);
 
+			// invalidates all cached layouts, has to be called on every change that is visible in a layer
+			void LayoutChanged();
+
+			// returns all updates newer than updateIDClient without waiting
+			// if the client has fallen behind the oldest stored update a resync event is returned first
+			void CollectUpdates(unsigned int& updateIDClient, std::string& s);
+
+			// sends the updates to all event streams with one thread
+			void UpdateSender();
+
 			volatile bool run;
 			unsigned int lastClientID;
-			std::vector<WebClient*> clients;
+			unsigned int rejectedClients;
+			const unsigned int maxClients;
+			std::map<Network::TcpConnection*,WebClient*> clients;
+			std::mutex clientsMutex;
 			Manager& manager;
 
-			std::map<unsigned int,std::string> updates;
+			const unsigned int InitialUpdates = 10;
+			// ring buffer, update with ID n is stored at n % maxUpdates
+			std::vector<std::string> updates;
 			std::mutex updateMutex;
+			std::condition_variable updateCondition;
 			unsigned int updateID;
-			const unsigned int MaxUpdates = 10;
+			const unsigned int maxUpdates;
+			const unsigned int UpdateWaitTimeout = 10; // seconds
 			const std::string updateStatus = "data: status=";
+
+			struct UpdateStream
+			{
+				// next update to collect
+				unsigned int updateID;
+				// collected updates the socket could not take yet
+				std::string pending;
+			};
+			// locked before updateMutex if both are needed
+			std::map<Network::TcpConnection*,UpdateStream> updateStreams;
+			std::mutex updateStreamsMutex;
+			// set when a stream has been added, locked with updateMutex
+			bool updateStreamAdded;
+			std::thread updateSenderThread;
+			const unsigned int UpdateRetryInterval = 100; // milliseconds
+
+			// rendered layers, an entry is only valid if its etag matches the current layout generation
+			std::map<LayerID,std::pair<std::string,std::string>> layoutCache;
+			std::mutex layoutCacheMutex;
+			unsigned int layoutGeneration;
+			const std::string layoutETagPrefix;
+
+			FileCache files;
 	};
 } // namespace WebServer
 
@@ -974,6 +974,11 @@ function dataUpdate(event)
 	{
 		loadLayerSelector();
 	}
+	else if (command == 'resync')
+	{
+		loadLoco();
+		loadLayout();
+	}
 	else if (command == 'dcccvvalue')
 	{
 		var cv = argumentMap.get('cv');
@@ -1317,7 +1322,8 @@ function addResponse(response)
 
 function submitEditForm()
 {
-	var url = '/?';
+	// forms are sent as POST request because they can exceed the maximum URL length
+	var body = '';
 	var form = document.getElementById('editform');
 	var i = 0;
 	while (true)
@@ -1329,17 +1335,17 @@ function submitEditForm()
 		}
 		if (i > 0)
 		{
-			url += '&';
+			body += '&';
 		}
-		url += formElement.name;
-		url += '=';
+		body += encodeURIComponent(formElement.name);
+		body += '=';
 		if (formElement.type == 'checkbox')
 		{
-			url += formElement.checked;
+			body += formElement.checked;
 		}
 		else
 		{
-			url += formElement.value;
+			body += encodeURIComponent(formElement.value);
 		}
 		++i;
 	}
@@ -1351,8 +1357,9 @@ function submitEditForm()
 		}
 		addResponse(xmlHttp.responseText);
 	}
-	xmlHttp.open('GET', url, true);
-	xmlHttp.send(null);
+	xmlHttp.open('POST', '/', true);
+	xmlHttp.setRequestHeader('Content-Type', 'application/x-www-form-urlencoded');
+	xmlHttp.send(body);
 	return false;
 }
 
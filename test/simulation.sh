@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# Builds a synthetic ring layout driven by the simulation control in an empty
+# database, runs all locos in automode and prints the statistics of the simulation.
+# usage: simulation.sh [number of locos] [duration in seconds] [section time in ms]
+
+LOCOS=${1:-100}
+DURATION=${2:-60}
+SECTIONTIME=${3:-1000}
+TRACKS=$((LOCOS * 2))
+PORT=8080
+URL="http://localhost:$PORT/"
+RAILCONTROL=${RAILCONTROL:-$(cd "$(dirname "$0")/.." && pwd)/railcontrol}
+
+WORKDIR=`mktemp -d`
+cd $WORKDIR
+cp -r "$(dirname "$RAILCONTROL")/html" . 2> /dev/null
+
+echo Starting railcontrol in $WORKDIR
+$RAILCONTROL --silent --logfile=railcontrol.log &
+PID=$!
+while ! curl -s -o /dev/null $URL ; do
+	sleep 1
+done
+
+request() {
+	curl -s -o /dev/null "$URL?$1"
+}
+
+echo Creating layout with $LOCOS locos on $TRACKS tracks
+request "cmd=controlsave&control=0&name=Simulation&hardwaretype=12&arg1=$SECTIONTIME"
+CONTROL=10
+
+# every track has a feedback to reduce the speed and one to stop
+for track in `seq 1 $TRACKS` ; do
+	request "cmd=feedbacksave&feedback=0&name=Reduced$track&control=$CONTROL&pin=$((track * 2 - 1))"
+	request "cmd=feedbacksave&feedback=0&name=Stop$track&control=$CONTROL&pin=$((track * 2))"
+	# a new track links its feedbacks only when it is saved a second time
+	POSITION="posx=$((track % 64))&posy=$((track / 64))"
+	request "cmd=tracksave&track=0&name=Track$track&$POSITION"
+	request "cmd=tracksave&track=$track&name=Track$track&$POSITION&feedbackcounter=2&feedback_1=$((track * 2 - 1))&feedback_2=$((track * 2))"
+done
+
+# the routes connect the tracks to a ring
+for track in `seq 1 $TRACKS` ; do
+	next=$((track % TRACKS + 1))
+	request "cmd=routesave&route=0&name=Route$track&automode=true&fromtrack=track$track&totrack=track$next&feedbackreduced=$((next * 2 - 1))&feedbackstop=$((next * 2))"
+done
+
+request "cmd=booster&on=true"
+for loco in `seq 1 $LOCOS` ; do
+	request "cmd=locosave&loco=0&name=Loco$loco&control=$CONTROL&protocol=0&address=$loco"
+	request "cmd=tracksetloco&track=$((loco * 2))&loco=$loco"
+done
+
+# a running loco would reserve the tracks of the locos not yet placed
+for loco in `seq 1 $LOCOS` ; do
+	request "cmd=trackstartloco&track=$((loco * 2))"
+done
+
+echo Running for $DURATION seconds
+sleep $DURATION
+grep "Simulation Simulation:" railcontrol.log
+
+kill -TERM $PID
+wait $PID
+cd - > /dev/null
+rm -rf $WORKDIR
+echo Railcontrol stopped